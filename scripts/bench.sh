@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+# Build and run the PSX Verb DSP benchmark
+#
+# Builds natively by default. Set CROSS_PREFIX (e.g. aarch64-linux-gnu-) to
+# cross-compile for Move and skip running; copy build/psxverb_bench over and
+# run it on the device. Extra arguments are passed to the benchmark.
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_ROOT="$(dirname "$SCRIPT_DIR")"
+
+cd "$REPO_ROOT"
+mkdir -p build
+
+if [ -n "$CROSS_PREFIX" ]; then
+    ARCH_FLAGS="-march=armv8-a -mtune=cortex-a72"
+else
+    ARCH_FLAGS="-march=native"
+fi
+
+# Same optimisation flags as scripts/build.sh so the numbers match the module
+echo "Compiling benchmark..."
+${CROSS_PREFIX}gcc -Ofast \
+    $ARCH_FLAGS \
+    -fomit-frame-pointer -fno-stack-protector \
+    -DNDEBUG \
+    src/bench/psxverb_bench.c \
+    -o build/psxverb_bench \
+    -Isrc/dsp \
+    -lm
+
+if [ -n "$CROSS_PREFIX" ]; then
+    echo "Output: build/psxverb_bench"
+    exit 0
+fi
+
+./build/psxverb_bench "$@"
@@ -3,6 +3,7 @@
 #
 # Automatically uses Docker for cross-compilation if needed.
 # Set CROSS_PREFIX to skip Docker (e.g., for native ARM builds).
+# Set PSXVERB_CFLAGS for extra compiler flags (e.g., -DPSXVERB_PROFILE=1).
 set -e
 
 SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
@@ -26,6 +27,7 @@ if [ -z "$CROSS_PREFIX" ] && [ ! -f "/.dockerenv" ]; then
     docker run --rm \
         -v "$REPO_ROOT:/build" \
         -u "$(id -u):$(id -g)" \
+        -e PSXVERB_CFLAGS \
         -w /build \
         "$IMAGE_NAME" \
         ./scripts/build.sh
@@ -52,7 +54,7 @@ echo "Compiling DSP plugin..."
 ${CROSS_PREFIX}gcc -Ofast -shared -fPIC \
     -march=armv8-a -mtune=cortex-a72 \
     -fomit-frame-pointer -fno-stack-protector \
-    -DNDEBUG \
+    -DNDEBUG $PSXVERB_CFLAGS \
     src/dsp/psxverb.c \
     -o build/psxverb.so \
     -Isrc/dsp \
@@ -62,6 +64,9 @@ ${CROSS_PREFIX}gcc -Ofast -shared -fPIC \
 echo "Packaging..."
 cat src/module.json > dist/psxverb/module.json
 cat build/psxverb.so > dist/psxverb/psxverb.so
+if [ -f src/presets.bank ]; then
+    cat src/presets.bank > dist/psxverb/presets.bank
+fi
 chmod +x dist/psxverb/psxverb.so
 
 # Create tarball for release
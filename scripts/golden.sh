@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Build and run the PSX Verb golden render check
+#
+# Compares every render against the hashes tracked in src/bench/golden.hashes
+# and fails if they are missing; -w re-records them from the current tree.
+# Builds natively by default; set CROSS_PREFIX (e.g. aarch64-linux-gnu-) to
+# cross-compile for Move and skip running (run it on the device from the repo
+# root to check the NEON path). Extra arguments are passed to psxverb_golden.
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_ROOT="$(dirname "$SCRIPT_DIR")"
+
+cd "$REPO_ROOT"
+mkdir -p build
+
+if [ -n "$CROSS_PREFIX" ]; then
+    ARCH_FLAGS="-march=armv8-a -mtune=cortex-a72"
+else
+    ARCH_FLAGS="-march=native"
+fi
+
+# Strict IEEE float (no -ffast-math, no FMA contraction) so the Float
+# reference only changes when the arithmetic does, not when a refactor moves
+# code between functions. Goldens still only carry over between builds with
+# the same compiler and flags. Add -Ofast via PSXVERB_CFLAGS (with -t) to
+# check the module's own flags.
+echo "Compiling golden check..."
+${CROSS_PREFIX}gcc -O2 -ffp-contract=off \
+    $ARCH_FLAGS \
+    -fomit-frame-pointer -fno-stack-protector \
+    -DNDEBUG \
+    $PSXVERB_CFLAGS \
+    src/bench/psxverb_golden.c \
+    -o build/psxverb_golden \
+    -Isrc/dsp \
+    -lm
+
+if [ -n "$CROSS_PREFIX" ]; then
+    echo "Output: build/psxverb_golden"
+    exit 0
+fi
+
+./build/psxverb_golden "$@"
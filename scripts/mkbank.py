@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Build a PSX Verb preset bank (presets.bank) from a JSON list of SPU dumps.
+
+Each entry:
+  {
+    "name": "Cave",                       # up to 23 printable chars, no " or \\
+    "work_size": "0x26C0",                # work area in bytes at 44.1kHz
+    "registers": ["0x007D", ...],         # 32 values, SPU order 0x1F801DC0-0x1F801DFE:
+                                          #   dAPF1 dAPF2 vIIR vCOMB1 vCOMB2 vCOMB3 vCOMB4
+                                          #   vWALL vAPF1 vAPF2 mLSAME mRSAME mLCOMB1
+                                          #   mRCOMB1 mLCOMB2 mRCOMB2 dLSAME dRSAME mLDIFF
+                                          #   mRDIFF mLCOMB3 mRCOMB3 mLCOMB4 mRCOMB4 dLDIFF
+                                          #   dRDIFF mLAPF1 mRAPF1 mLAPF2 mRAPF2 vLIN vRIN
+    "vLOUT": "0x8000", "vROUT": "0x8000"  # optional, default 0x8000
+  }
+
+Values are ints or hex strings in the units of the built-in presets
+(src/dsp/psxverb.c g_presets). The plugin checks the same limits on load and
+ignores a bank that fails them.
+
+Usage: scripts/mkbank.py presets.json [-o src/presets.bank]
+"""
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"PSXB"
+VERSION = 1
+RECORD = struct.Struct("<32H2hI24s")
+HEADER = struct.Struct("<4sHHII")
+MAX_PRESETS = 1024
+WORK_MAX = 0x10000
+VOLUME_REGS = set(range(2, 10)) | {30, 31}
+
+
+def num(v):
+    return int(v, 0) if isinstance(v, str) else int(v)
+
+
+def record(entry, index):
+    where = "preset %d (%s)" % (index, entry.get("name", "?"))
+    name = entry["name"]
+    if not 0 < len(name) < 24 or any(c in name for c in '"\\') or \
+            not all(0x20 <= ord(c) <= 0x7E for c in name):
+        sys.exit("%s: bad name" % where)
+    work_size = num(entry["work_size"])
+    if not 2 <= work_size <= WORK_MAX:
+        sys.exit("%s: work_size out of range" % where)
+    regs = [num(v) & 0xFFFF for v in entry["registers"]]
+    if len(regs) != 32:
+        sys.exit("%s: need 32 registers" % where)
+    for r, v in enumerate(regs):
+        if r not in VOLUME_REGS and v >= work_size // 2:
+            sys.exit("%s: register %d (0x%04X) outside the work area" % (where, r, v))
+    louts = [num(entry.get(k, 0x8000)) & 0xFFFF for k in ("vLOUT", "vROUT")]
+    louts = [v - 0x10000 if v >= 0x8000 else v for v in louts]
+    return RECORD.pack(*regs, *louts, work_size, name.encode("ascii"))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input")
+    ap.add_argument("-o", "--output", default="src/presets.bank")
+    args = ap.parse_args()
+
+    with open(args.input) as f:
+        entries = json.load(f)
+    if len(entries) > MAX_PRESETS:
+        sys.exit("at most %d presets per bank" % MAX_PRESETS)
+
+    data = HEADER.pack(MAGIC, VERSION, len(entries), RECORD.size, 0)
+    data += b"".join(record(e, i) for i, e in enumerate(entries))
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("%s: %d presets, %d bytes" % (args.output, len(entries), len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,313 @@
+/*
+ * PSX Verb benchmark - host-free timing of the DSP hot path
+ *
+ * Links psxverb.c directly (single TU) and drives it through
+ * move_audio_fx_init_v2() with a stub host_api_v1_t, so the measured code is
+ * exactly what the module ships. For every preset:
+ * - N instances run blocks of noise (128 frames, or -f) through process_block,
+ *   or with -F through process_block_f32 on planar float buffers
+ * - ns/block, ns/frame and real-time factor (block duration / time to
+ *   process it) are reported per instance
+ * - each block pass is also timed in isolation for a per-stage breakdown
+ * - cache misses are counted via perf_event_open where the kernel allows it
+ * - with -B K, each instance is a K-bus one driven through
+ *   process_block_multi; timings are per bus so they compare with -B 1
+ *
+ * Built by scripts/bench.sh (native by default, CROSS_PREFIX for aarch64).
+ *
+ * Usage: psxverb_bench [-n instances] [-b blocks] [-e Float|Fixed] [-r rate] [-f frames] [-R resampler] [-F] [-B buses]
+ */
+
+#define _GNU_SOURCE
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+#include "psxverb.c"
+
+#define BENCH_MAX_INSTANCES 64
+#define BENCH_WARMUP_BLOCKS 256
+#define BENCH_MAX_FRAMES 1024
+
+/* ============================================================================
+ * TIMING AND COUNTERS
+ * ============================================================================ */
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Hardware cache-miss counter for this thread, or -1 if unavailable */
+static int counter_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void counter_start(int fd) {
+#ifdef __linux__
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+static int64_t counter_stop(int fd) {
+#ifdef __linux__
+    uint64_t value;
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) return -1;
+    return (int64_t)value;
+#else
+    return -1;
+#endif
+}
+
+/* ============================================================================
+ * INPUT
+ * ============================================================================ */
+
+static uint32_t g_rng = 0x12345678u;
+
+/* Quiet-ish stereo noise, same sequence every run */
+static void fill_noise(int16_t *buf, int frames) {
+    for (int i = 0; i < frames * 2; i++) {
+        g_rng = g_rng * 1664525u + 1013904223u;
+        buf[i] = (int16_t)((int32_t)(g_rng >> 16) - 32768) / 4;
+    }
+}
+
+/* Per-instance input and the buffer each call processes in place */
+static int16_t g_input[BENCH_MAX_INSTANCES][BENCH_MAX_FRAMES * 2];
+static int16_t g_buf[BENCH_MAX_INSTANCES][BENCH_MAX_FRAMES * 2];
+static float g_input_f[BENCH_MAX_INSTANCES][2][BENCH_MAX_FRAMES];  /* Planar copy */
+static float g_buf_f[BENCH_MAX_INSTANCES][2][BENCH_MAX_FRAMES];
+
+static void fill_input(int i) {
+    fill_noise(g_input[i], BENCH_MAX_FRAMES);
+    for (int j = 0; j < BENCH_MAX_FRAMES; j++) {
+        g_input_f[i][0][j] = g_input[i][j * 2] / 32768.0f;
+        g_input_f[i][1][j] = g_input[i][j * 2 + 1] / 32768.0f;
+    }
+}
+
+/* One process call on instance slot i from fresh input. A K-bus instance
+ * uses slots i * K to i * K + K - 1. */
+static void bench_call(audio_fx_api_v2_t *api, void *inst, int i, int frames, int use_f32, int buses) {
+    if (buses > 1) {
+        int16_t *bufs[PSXVERB_MAX_BUSES];
+        for (int b = 0; b < buses; b++) {
+            int slot = i * buses + b;
+            memcpy(g_buf[slot], g_input[slot], (size_t)frames * 2 * sizeof(int16_t));
+            bufs[b] = g_buf[slot];
+        }
+        api->process_block_multi(inst, bufs, buses, frames);
+    } else if (use_f32) {
+        memcpy(g_buf_f[i][0], g_input_f[i][0], (size_t)frames * sizeof(float));
+        memcpy(g_buf_f[i][1], g_input_f[i][1], (size_t)frames * sizeof(float));
+        api->process_block_f32(inst, g_buf_f[i][0], g_buf_f[i][1], 1, frames);
+    } else {
+        memcpy(g_buf[i], g_input[i], (size_t)frames * 2 * sizeof(int16_t));
+        api->process_block(inst, g_buf[i], frames);
+    }
+}
+
+/* Stops the compiler hoisting or merging the repeated stage calls */
+#define BENCH_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+static void bench_log(const char *msg) {
+    (void)msg;
+}
+
+/* ============================================================================
+ * STAGE BREAKDOWN
+ * Runs each block pass on its own over one warmed-up instance's state.
+ * ============================================================================ */
+
+enum { STAGE_TO_FLOAT, STAGE_DECIMATE, STAGE_SPU, STAGE_INTERPOLATE, STAGE_MIX, STAGE_COUNT };
+
+static const char *const g_stage_names[STAGE_COUNT] = {
+    "to_float", "decimate", "spu", "interp", "mix"
+};
+
+static void bench_stages(psxverb_instance_t *inst, const int16_t *input, int blocks,
+                         double *ns_per_block) {
+    block_scratch_t s;
+    int16_t out[BLOCK_FRAMES * 2];
+    spu_kernel_fn kernel = inst->kernel;
+    const resampler_kernels_t *rs = &g_resamplers[inst->live.resampler];
+    spu_core_t *core = &inst->core[inst->active];
+    uint64_t t0;
+
+    block_to_float(input, s.in_l, s.in_r, BLOCK_FRAMES);
+
+    t0 = now_ns();
+    for (int b = 0; b < blocks; b++) {
+        block_to_float(input, s.in_l, s.in_r, BLOCK_FRAMES);
+        BENCH_BARRIER();
+    }
+    ns_per_block[STAGE_TO_FLOAT] = (double)(now_ns() - t0) / blocks;
+
+    t0 = now_ns();
+    for (int b = 0; b < blocks; b++) {
+        rs->decimate(&inst->down, s.in_l, s.in_r, s.tick_l, s.tick_r, BLOCK_TICKS);
+        BENCH_BARRIER();
+    }
+    ns_per_block[STAGE_DECIMATE] = (double)(now_ns() - t0) / blocks;
+
+    t0 = now_ns();
+    for (int b = 0; b < blocks; b++) {
+        kernel(&core->work, &inst->current, s.tick_l, s.tick_r, s.fade_l, s.fade_r, BLOCK_TICKS);
+        BENCH_BARRIER();
+    }
+    ns_per_block[STAGE_SPU] = (double)(now_ns() - t0) / blocks;
+
+    t0 = now_ns();
+    for (int b = 0; b < blocks; b++) {
+        rs->interpolate(&inst->up, s.fade_l, s.fade_r, s.wet_l, s.wet_r, BLOCK_TICKS);
+        BENCH_BARRIER();
+    }
+    ns_per_block[STAGE_INTERPOLATE] = (double)(now_ns() - t0) / blocks;
+
+    t0 = now_ns();
+    for (int b = 0; b < blocks; b++) {
+        block_mix_blend(s.in_l, s.in_r, s.wet_l, s.wet_r, inst->mix_cur, s.wet_l, s.wet_r, BLOCK_FRAMES);
+        block_store_int16(s.wet_l, s.wet_r, out, BLOCK_FRAMES);
+        BENCH_BARRIER();
+    }
+    ns_per_block[STAGE_MIX] = (double)(now_ns() - t0) / blocks;
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================ */
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-n instances] [-b blocks] [-e Float|Fixed] [-r rate] [-f frames] [-R resampler] [-F] [-B buses]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    int instances = 4;
+    int blocks = 20000;
+    int rate = MOVE_SAMPLE_RATE;
+    int frames = BLOCK_FRAMES;
+    const char *engine = "Float";
+    const char *resampler = "39-tap";
+    int use_f32 = 0;
+    int buses = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:b:e:r:f:R:FB:h")) != -1) {
+        switch (opt) {
+            case 'n': instances = atoi(optarg); break;
+            case 'b': blocks = atoi(optarg); break;
+            case 'e': engine = optarg; break;
+            case 'r': rate = atoi(optarg); break;
+            case 'f': frames = atoi(optarg); break;
+            case 'R': resampler = optarg; break;
+            case 'F': use_f32 = 1; break;
+            case 'B': buses = atoi(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (instances < 1 || instances > BENCH_MAX_INSTANCES || blocks < 1 ||
+        frames < 1 || frames > BENCH_MAX_FRAMES || buses < 1 || buses > PSXVERB_MAX_BUSES ||
+        instances * buses > BENCH_MAX_INSTANCES || (buses > 1 && use_f32)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = rate;
+    host.frames_per_block = MOVE_FRAMES_PER_BLOCK;
+    host.log = bench_log;
+
+    audio_fx_api_v2_t *api = move_audio_fx_init_v2(&host);
+    if (!api) return 1;
+
+    for (int i = 0; i < instances * buses; i++) fill_input(i);
+    char config[32];
+    snprintf(config, sizeof(config), "{\"buses\":%d}", buses);
+
+    double block_ns = 1e9 * frames / (double)rate;
+    int counter = counter_open();
+
+    printf("psxverb_bench: %d instance(s) x %d bus(es), %d blocks of %d frames, %s engine, %s resampler, %s, %d Hz",
+           instances, buses, blocks, frames, engine, resampler, use_f32 ? "f32 planar" : "int16", rate);
+#if PSXVERB_USE_NEON
+    printf(", NEON\n");
+#else
+    printf(", scalar\n");
+#endif
+    printf("%-10s %10s %9s %8s %10s", "preset", "ns/block", "ns/frame", "RTF", "misses/blk");
+    for (int st = 0; st < STAGE_COUNT; st++) printf(" %9s", g_stage_names[st]);
+    printf("\n");
+
+    for (int p = 0; p < PRESET_COUNT; p++) {
+        void *inst[BENCH_MAX_INSTANCES];
+        char val[16];
+        snprintf(val, sizeof(val), "%d", p);
+
+        for (int i = 0; i < instances; i++) {
+            inst[i] = api->create_instance("", buses > 1 ? config : NULL);
+            if (!inst[i]) {
+                fprintf(stderr, "create_instance failed\n");
+                return 1;
+            }
+            api->set_param(inst[i], "engine", engine);
+            api->set_param(inst[i], "resampler", resampler);
+            api->set_param(inst[i], "crossfade", "0");
+            api->set_param(inst[i], "preset", val);
+        }
+
+        /* Let the preset switch and the parameter ramps finish */
+        for (int b = 0; b < BENCH_WARMUP_BLOCKS; b++) {
+            for (int i = 0; i < instances; i++) bench_call(api, inst[i], i, frames, use_f32, buses);
+        }
+
+        counter_start(counter);
+        uint64_t t0 = now_ns();
+        for (int b = 0; b < blocks; b++) {
+            for (int i = 0; i < instances; i++) bench_call(api, inst[i], i, frames, use_f32, buses);
+        }
+        uint64_t elapsed = now_ns() - t0;
+        int64_t misses = counter_stop(counter);
+
+        double ns = (double)elapsed / ((double)blocks * instances * buses);
+        double stage_ns[STAGE_COUNT] = {0};
+        if (buses == 1) bench_stages((psxverb_instance_t*)inst[0], g_input[0], blocks, stage_ns);
+
+        printf("%-10s %10.0f %9.2f %7.1fx", g_presets[p].name, ns, ns / frames, block_ns / ns);
+        if (misses >= 0) {
+            printf(" %10.1f", (double)misses / ((double)blocks * instances * buses));
+        } else {
+            printf(" %10s", "n/a");
+        }
+        for (int st = 0; st < STAGE_COUNT; st++) printf(" %9.0f", stage_ns[st]);
+        printf("\n");
+
+        for (int i = 0; i < instances; i++) api->destroy_instance(inst[i]);
+    }
+
+    if (counter >= 0) close(counter);
+    return 0;
+}
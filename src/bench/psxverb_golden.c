@@ -0,0 +1,558 @@
+/*
+ * PSX Verb golden renders - regression check for the DSP output
+ *
+ * Links psxverb.c directly (single TU) like psxverb_bench and renders a fixed
+ * grid of cases through move_audio_fx_init_v2() with a stub host_api_v1_t:
+ * - impulse, log sine sweep and noise
+ * - each of the six presets
+ * - four decay / mix / input_gain / reverb_level settings
+ * - both engines, at 44.1 and 48 kHz
+ * plus, per preset, a 4-bus instance against four single instances over
+ * odd and one-frame blocks, which must match bit for bit.
+ *
+ * Every render is hashed (FNV-1a 64 over the int16 output) and checked
+ * against src/bench/golden.hashes, which is tracked in git. Hashes are keyed
+ * by rate, SIMD path (scalar or neon), engine and case; a missing file or
+ * entry fails the check. -w records the current build's hashes into the
+ * file, replacing only the entries it renders.
+ *
+ * -d dir also keeps full raw renders (one interleaved int16 file per case
+ * and engine) for a closer look: -w writes them, a compare run reads them
+ * and reports the largest difference in LSB and the SNR. With raw goldens a
+ * hash mismatch can still pass:
+ * - Float, the reference port, within -t LSB (0 by default, bit-exact)
+ * - Fixed with at least -s dB SNR
+ * How far Fixed is from Float and the real-time factor of each render are
+ * reported alongside. Exits non-zero if any case fails.
+ *
+ * Hashes hold only for the strict float build in scripts/golden.sh.
+ *
+ * Built by scripts/golden.sh.
+ *
+ * Usage: psxverb_golden [-w] [-f hashes] [-d dir] [-r rate] [-t lsb] [-s snr_db]
+ */
+
+#define _GNU_SOURCE
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "psxverb.c"
+
+#define GOLDEN_SECONDS 2
+#define GOLDEN_FIXED_SNR_DB 60.0
+
+/* ============================================================================
+ * CASES
+ * ============================================================================ */
+
+enum { SIGNAL_IMPULSE, SIGNAL_SWEEP, SIGNAL_NOISE, SIGNAL_COUNT };
+
+static const char *const g_signal_names[SIGNAL_COUNT] = {
+    "impulse", "sweep", "noise"
+};
+
+typedef struct {
+    const char *decay;
+    const char *mix;
+    const char *input_gain;
+    const char *reverb_level;
+} golden_setting_t;
+
+static const golden_setting_t g_settings[] = {
+    {"0.7", "0.35", "0.5", "0.5"},      /* module defaults */
+    {"0.0", "1.0", "0.5", "0.5"},       /* no wall feedback, wet only */
+    {"1.0", "1.0", "1.0", "1.0"},       /* everything up, saturates */
+    {"0.4", "0.6", "0.25", "0.8"},
+};
+
+#define SETTING_COUNT ((int)(sizeof(g_settings) / sizeof(g_settings[0])))
+#define CASE_COUNT (PRESET_COUNT * SIGNAL_COUNT * SETTING_COUNT)
+
+/* A render passes if it is within max_lsb of its golden or, failing that,
+ * keeps at least min_snr_db signal to error ratio */
+typedef struct {
+    const char *engine;
+    int max_lsb;
+    double min_snr_db;
+} golden_tolerance_t;
+
+enum { GOLDEN_FLOAT, GOLDEN_FIXED, GOLDEN_ENGINES };
+
+/* Test signal, stereo interleaved. Both channels differ so L/R swaps show. */
+static void fill_signal(int signal, int rate, int16_t *buf, int frames) {
+    uint32_t rng = 0x12345678u;
+    memset(buf, 0, (size_t)frames * 2 * sizeof(int16_t));
+
+    switch (signal) {
+        case SIGNAL_IMPULSE:
+            buf[0] = 16384;
+            buf[1] = -16384;
+            break;
+
+        case SIGNAL_SWEEP: {
+            /* 20 Hz to 20 kHz log sweep over the first half, -6 dBFS */
+            int len = frames / 2;
+            double f0 = 20.0, f1 = 20000.0;
+            double k = log(f1 / f0);
+            double dur = (double)len / rate;
+            for (int i = 0; i < len; i++) {
+                double t = (double)i / rate;
+                double ph = 2.0 * M_PI * f0 * dur / k * (exp(t / dur * k) - 1.0);
+                buf[i * 2] = (int16_t)lrint(16384.0 * sin(ph));
+                buf[i * 2 + 1] = (int16_t)lrint(16384.0 * cos(ph));
+            }
+            break;
+        }
+
+        case SIGNAL_NOISE:
+            /* -12 dBFS noise burst over the first half */
+            for (int i = 0; i < frames / 2; i++) {
+                rng = rng * 1664525u + 1013904223u;
+                buf[i * 2] = (int16_t)(((int32_t)(rng >> 16) - 32768) / 4);
+                rng = rng * 1664525u + 1013904223u;
+                buf[i * 2 + 1] = (int16_t)(((int32_t)(rng >> 16) - 32768) / 4);
+            }
+            break;
+    }
+}
+
+/* ============================================================================
+ * RENDERING
+ * ============================================================================ */
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void golden_log(const char *msg) {
+    (void)msg;
+}
+
+/* Render one case through a fresh instance; returns elapsed ns or 0 on error */
+static uint64_t render_case(audio_fx_api_v2_t *api, const char *engine, int preset,
+                            const golden_setting_t *set, const int16_t *input,
+                            int16_t *out, int frames) {
+    char val[16];
+    void *inst = api->create_instance("", NULL);
+    if (!inst) return 0;
+
+    snprintf(val, sizeof(val), "%d", preset);
+    api->set_param(inst, "engine", engine);
+    api->set_param(inst, "crossfade", "0");
+    api->set_param(inst, "preset", val);
+    api->set_param(inst, "decay", set->decay);
+    api->set_param(inst, "mix", set->mix);
+    api->set_param(inst, "input_gain", set->input_gain);
+    api->set_param(inst, "reverb_level", set->reverb_level);
+
+    memcpy(out, input, (size_t)frames * 2 * sizeof(int16_t));
+    uint64_t t0 = now_ns();
+    for (int f = 0; f < frames; f += BLOCK_FRAMES) {
+        api->process_block(inst, out + f * 2, BLOCK_FRAMES);
+    }
+    uint64_t elapsed = now_ns() - t0;
+
+    api->destroy_instance(inst);
+    return elapsed ? elapsed : 1;
+}
+
+/* ============================================================================
+ * MULTI-BUS
+ * A GOLDEN_BUSES-bus instance must match as many single instances fed the
+ * same blocks bit for bit, including odd and one-frame blocks (carry mode).
+ * ============================================================================ */
+
+#define GOLDEN_BUSES 4
+
+static const int g_bus_block_sizes[] = { 128, 127, 1, 64, 33, 2, 127, 128 };
+#define BUS_BLOCK_SIZE_COUNT ((int)(sizeof(g_bus_block_sizes) / sizeof(g_bus_block_sizes[0])))
+
+/* Returns the number of differing output samples, or -1 on error */
+static long check_multibus(audio_fx_api_v2_t *api, int preset, int rate, int frames) {
+    char val[16];
+    snprintf(val, sizeof(val), "{\"buses\": %d}", GOLDEN_BUSES);
+    void *multi = api->create_instance("", val);
+    void *single[GOLDEN_BUSES] = {0};
+    size_t bytes = (size_t)frames * 2 * sizeof(int16_t);
+    int16_t *mbuf[GOLDEN_BUSES], *sbuf[GOLDEN_BUSES];
+    long diff = multi ? 0 : -1;
+
+    snprintf(val, sizeof(val), "%d", preset);
+    for (int b = 0; b < GOLDEN_BUSES; b++) {
+        single[b] = api->create_instance("", NULL);
+        mbuf[b] = malloc(bytes);
+        sbuf[b] = malloc(bytes);
+        if (!single[b] || !mbuf[b] || !sbuf[b]) diff = -1;
+    }
+    if (diff == 0) {
+        api->set_param(multi, "preset", val);
+        for (int b = 0; b < GOLDEN_BUSES; b++) {
+            api->set_param(single[b], "preset", val);
+            fill_signal(b % SIGNAL_COUNT, rate, mbuf[b], frames);
+            memcpy(sbuf[b], mbuf[b], bytes);
+        }
+        for (int f = 0, i = 0; f < frames; i++) {
+            int n = g_bus_block_sizes[i % BUS_BLOCK_SIZE_COUNT];
+            if (n > frames - f) n = frames - f;
+            int16_t *ptr[GOLDEN_BUSES];
+            for (int b = 0; b < GOLDEN_BUSES; b++) ptr[b] = mbuf[b] + f * 2;
+            api->process_block_multi(multi, ptr, GOLDEN_BUSES, n);
+            for (int b = 0; b < GOLDEN_BUSES; b++) api->process_block(single[b], sbuf[b] + f * 2, n);
+            f += n;
+        }
+        for (int b = 0; b < GOLDEN_BUSES; b++) {
+            for (int i = 0; i < frames * 2; i++) diff += mbuf[b][i] != sbuf[b][i];
+        }
+    }
+
+    for (int b = 0; b < GOLDEN_BUSES; b++) {
+        if (single[b]) api->destroy_instance(single[b]);
+        free(mbuf[b]);
+        free(sbuf[b]);
+    }
+    if (multi) api->destroy_instance(multi);
+    return diff;
+}
+
+/* ============================================================================
+ * GOLDEN HASHES
+ * One line per render: "<rate> <path> <engine> <case> <fnv1a64 hex>".
+ * Lines starting with '#' are comments and are kept when recording.
+ * ============================================================================ */
+
+#define GOLDEN_HASHES "src/bench/golden.hashes"
+#define GOLDEN_KEY_MAX 96
+
+#if PSXVERB_USE_NEON
+#define GOLDEN_PATH "neon"
+#else
+#define GOLDEN_PATH "scalar"
+#endif
+
+typedef struct {
+    char key[GOLDEN_KEY_MAX];
+    uint64_t hash;
+} golden_hash_t;
+
+typedef struct {
+    golden_hash_t *entries;
+    int count;
+    int capacity;
+    char *comments;     /* Header lines, verbatim */
+} golden_hashes_t;
+
+static uint64_t fnv1a64(const int16_t *buf, int frames) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    const uint8_t *b = (const uint8_t*)buf;
+    for (size_t i = 0; i < (size_t)frames * 2 * sizeof(int16_t); i++) {
+        h ^= b[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static void golden_key(char *key, int rate, const char *engine, const char *name) {
+    snprintf(key, GOLDEN_KEY_MAX, "%d %s %s %s", rate, GOLDEN_PATH, engine, name);
+}
+
+static golden_hash_t *golden_find(golden_hashes_t *g, const char *key) {
+    for (int i = 0; i < g->count; i++) {
+        if (strcmp(g->entries[i].key, key) == 0) return &g->entries[i];
+    }
+    return NULL;
+}
+
+static golden_hash_t *golden_add(golden_hashes_t *g, const char *key) {
+    golden_hash_t *e = golden_find(g, key);
+    if (e) return e;
+    if (g->count == g->capacity) {
+        int cap = g->capacity ? g->capacity * 2 : 256;
+        golden_hash_t *n = realloc(g->entries, (size_t)cap * sizeof(*n));
+        if (!n) return NULL;
+        g->entries = n;
+        g->capacity = cap;
+    }
+    e = &g->entries[g->count++];
+    snprintf(e->key, sizeof(e->key), "%s", key);
+    e->hash = 0;
+    return e;
+}
+
+/* Returns -1 if the file cannot be opened */
+static int golden_load(golden_hashes_t *g, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[256];
+    size_t comments = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') {
+            size_t n = strlen(line);
+            char *c = realloc(g->comments, comments + n + 1);
+            if (!c) break;
+            memcpy(c + comments, line, n + 1);
+            g->comments = c;
+            comments += n;
+            continue;
+        }
+        int rate;
+        char path_name[16], engine[16], name[32];
+        unsigned long long hash;
+        if (sscanf(line, "%d %15s %15s %31s %llx", &rate, path_name, engine, name, &hash) != 5) {
+            continue;
+        }
+        char key[GOLDEN_KEY_MAX];
+        snprintf(key, sizeof(key), "%d %s %s %s", rate, path_name, engine, name);
+        golden_hash_t *e = golden_add(g, key);
+        if (e) e->hash = hash;
+    }
+    fclose(f);
+    return 0;
+}
+
+static int golden_save(const golden_hashes_t *g, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    fputs(g->comments ? g->comments
+                      : "# PSX Verb golden hashes, see src/bench/psxverb_golden.c\n", f);
+    for (int i = 0; i < g->count; i++) {
+        fprintf(f, "%s %016llx\n", g->entries[i].key, (unsigned long long)g->entries[i].hash);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* ============================================================================
+ * RAW GOLDEN FILES
+ * ============================================================================ */
+
+static void case_path(char *path, size_t size, const char *dir, int rate, const char *name,
+                      const char *engine) {
+    snprintf(path, size, "%s/%d_%s_%s.raw", dir, rate, name, engine);
+}
+
+static int golden_write(const char *path, const int16_t *buf, int frames) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+    size_t n = fwrite(buf, sizeof(int16_t) * 2, (size_t)frames, f);
+    fclose(f);
+    return n == (size_t)frames ? 0 : -1;
+}
+
+static int golden_read(const char *path, int16_t *buf, int frames) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return -1;
+    size_t n = fread(buf, sizeof(int16_t) * 2, (size_t)frames, f);
+    int extra = fgetc(f);
+    fclose(f);
+    return (n == (size_t)frames && extra == EOF) ? 0 : -1;
+}
+
+typedef struct {
+    int max_diff;       /* Largest per-sample difference in LSB */
+    double snr_db;      /* Golden energy over error energy */
+} golden_diff_t;
+
+static golden_diff_t golden_compare(const int16_t *ref, const int16_t *out, int frames) {
+    golden_diff_t d = {0, INFINITY};
+    double sig = 0.0, err = 0.0;
+    for (int i = 0; i < frames * 2; i++) {
+        int e = (int)out[i] - (int)ref[i];
+        if (abs(e) > d.max_diff) d.max_diff = abs(e);
+        sig += (double)ref[i] * ref[i];
+        err += (double)e * e;
+    }
+    if (err > 0.0) d.snr_db = sig > 0.0 ? 10.0 * log10(sig / err) : -INFINITY;
+    return d;
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================ */
+
+static const int g_golden_rates[] = { MOVE_SAMPLE_RATE, 48000 };
+#define GOLDEN_RATE_COUNT ((int)(sizeof(g_golden_rates) / sizeof(g_golden_rates[0])))
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-w] [-f hashes] [-d dir] [-r rate] [-t lsb] [-s snr_db]\n",
+            argv0);
+}
+
+/* Render and check (or record) every case at one rate; returns failures,
+ * or -1 on a setup error */
+static int golden_run_rate(int rate, int record, golden_hashes_t *hashes, const char *dir,
+                           const golden_tolerance_t *tol) {
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = rate;
+    host.frames_per_block = MOVE_FRAMES_PER_BLOCK;
+    host.log = golden_log;
+
+    audio_fx_api_v2_t *api = move_audio_fx_init_v2(&host);
+    if (!api) return -1;
+
+    int frames = (rate * GOLDEN_SECONDS / BLOCK_FRAMES) * BLOCK_FRAMES;
+    size_t bytes = (size_t)frames * 2 * sizeof(int16_t);
+    int16_t *input = malloc(bytes);
+    int16_t *golden = malloc(bytes);
+    int16_t *out[GOLDEN_ENGINES] = {malloc(bytes), malloc(bytes)};
+    if (!input || !golden || !out[GOLDEN_FLOAT] || !out[GOLDEN_FIXED]) return -1;
+
+    double audio_ns = 1e9 * frames / (double)rate;
+    int failures = 0;
+
+    printf("psxverb_golden: %s, %d Hz, %d frames per case, %s\n",
+           record ? "recording" : "comparing", rate, frames, GOLDEN_PATH);
+    if (!record) {
+        printf("%-18s %9s %8s %9s %8s %8s %12s  %s\n", "case", "float lsb", "RTF",
+               "fixed lsb", "snr dB", "RTF", "fixed/float", "result");
+    }
+
+    for (int p = 0; p < PRESET_COUNT; p++) {
+        for (int sig = 0; sig < SIGNAL_COUNT; sig++) {
+            fill_signal(sig, rate, input, frames);
+
+            for (int s = 0; s < SETTING_COUNT; s++) {
+                char name[32];
+                snprintf(name, sizeof(name), "p%d_%s_s%d", p, g_signal_names[sig], s);
+
+                char lsb[GOLDEN_ENGINES][16];
+                char snr[16] = "-";
+                double rtf[GOLDEN_ENGINES];
+                int ok = 1;
+
+                for (int e = 0; e < GOLDEN_ENGINES; e++) {
+                    char key[GOLDEN_KEY_MAX], path[512];
+                    golden_key(key, rate, tol[e].engine, name);
+                    if (dir) case_path(path, sizeof(path), dir, rate, name, tol[e].engine);
+
+                    uint64_t ns = render_case(api, tol[e].engine, p, &g_settings[s],
+                                              input, out[e], frames);
+                    if (!ns) {
+                        fprintf(stderr, "create_instance failed\n");
+                        return -1;
+                    }
+                    rtf[e] = audio_ns / (double)ns;
+                    uint64_t hash = fnv1a64(out[e], frames);
+
+                    if (record) {
+                        golden_hash_t *h = golden_add(hashes, key);
+                        if (!h) return -1;
+                        h->hash = hash;
+                        if (dir && golden_write(path, out[e], frames) != 0) {
+                            fprintf(stderr, "cannot write %s\n", path);
+                            return -1;
+                        }
+                        continue;
+                    }
+
+                    golden_hash_t *h = golden_find(hashes, key);
+                    int match = h && h->hash == hash;
+                    snprintf(lsb[e], sizeof(lsb[e]), "%s", match ? "0" : h ? "hash" : "missing");
+                    if (match) {
+                        if (e == GOLDEN_FIXED) snprintf(snr, sizeof(snr), "inf");
+                        continue;
+                    }
+
+                    /* Off the hash: only raw goldens within tolerance can pass */
+                    if (dir && h && golden_read(path, golden, frames) == 0) {
+                        golden_diff_t d = golden_compare(golden, out[e], frames);
+                        snprintf(lsb[e], sizeof(lsb[e]), "%d", d.max_diff);
+                        if (e == GOLDEN_FIXED) snprintf(snr, sizeof(snr), "%.1f", d.snr_db);
+                        if (d.max_diff <= tol[e].max_lsb || d.snr_db >= tol[e].min_snr_db) {
+                            continue;
+                        }
+                    }
+                    ok = 0;
+                }
+                if (record) continue;
+
+                golden_diff_t drift = golden_compare(out[GOLDEN_FLOAT], out[GOLDEN_FIXED], frames);
+                if (!ok) failures++;
+                printf("%-18s %9s %7.1fx %9s %8s %7.1fx %12.1f  %s\n", name,
+                       lsb[GOLDEN_FLOAT], rtf[GOLDEN_FLOAT], lsb[GOLDEN_FIXED], snr,
+                       rtf[GOLDEN_FIXED], drift.snr_db, ok ? "ok" : "FAIL");
+            }
+        }
+    }
+
+    for (int p = 0; p < PRESET_COUNT && !record; p++) {
+        char name[32];
+        snprintf(name, sizeof(name), "p%d_multibus", p);
+        long diff = check_multibus(api, p, rate, frames);
+        if (diff < 0) return -1;
+        if (diff) failures++;
+        printf("%-18s %9ld samples differ from %d single instances  %s\n", name, diff,
+               GOLDEN_BUSES, diff ? "FAIL" : "ok");
+    }
+
+    free(input);
+    free(golden);
+    free(out[GOLDEN_FLOAT]);
+    free(out[GOLDEN_FIXED]);
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    int record = 0;
+    const char *file = GOLDEN_HASHES;
+    const char *dir = NULL;
+    int rate = 0;
+    golden_tolerance_t tol[GOLDEN_ENGINES] = {
+        {"Float", 0, INFINITY},
+        {"Fixed", 0, GOLDEN_FIXED_SNR_DB},
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "wf:d:r:t:s:h")) != -1) {
+        switch (opt) {
+            case 'w': record = 1; break;
+            case 'f': file = optarg; break;
+            case 'd': dir = optarg; break;
+            case 'r': rate = atoi(optarg); break;
+            case 't': tol[GOLDEN_FLOAT].max_lsb = atoi(optarg); break;
+            case 's': tol[GOLDEN_FIXED].min_snr_db = atof(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if ((rate && (rate < MIN_SAMPLE_RATE || rate > MAX_SAMPLE_RATE)) ||
+        tol[GOLDEN_FLOAT].max_lsb < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    golden_hashes_t hashes = {0};
+    if (golden_load(&hashes, file) != 0 && !record) {
+        fprintf(stderr, "no goldens: cannot read %s (record them with -w)\n", file);
+        return 1;
+    }
+    if (record && dir && mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "cannot create %s: %s\n", dir, strerror(errno));
+        return 1;
+    }
+
+    int failures = 0, cases = 0;
+    for (int r = 0; r < GOLDEN_RATE_COUNT; r++) {
+        int run_rate = rate ? rate : g_golden_rates[r];
+        int n = golden_run_rate(run_rate, record, &hashes, dir, tol);
+        if (n < 0) return 1;
+        failures += n;
+        cases += record ? CASE_COUNT : CASE_COUNT + PRESET_COUNT;
+        if (rate) break;
+    }
+
+    if (record) {
+        if (golden_save(&hashes, file) != 0) {
+            fprintf(stderr, "cannot write %s\n", file);
+            return 1;
+        }
+        printf("recorded %d cases into %s\n", cases, file);
+        return 0;
+    }
+    printf("%d of %d cases failed\n", failures, cases);
+    return failures ? 1 : 0;
+}
@@ -6,21 +6,34 @@
  *
  * PSX SPU Reverb operates at 22.05kHz internally (half of 44.1kHz).
  * This implementation uses:
- * - Halfband 39-tap FIR for 2:1 decimation/interpolation
+ * - Halfband 39-tap FIR (polyphase) for 2:1 decimation/interpolation
  * - WorkArea circular int16 buffer emulating SPU RAM with saturating writes
  * - Authentic PSX SPU register values for 6 presets (exact hex from psx-spx)
  * - Full PSX algorithm: Same/Diff reflections -> Comb -> APF1 -> APF2
+ * - Delays scaled to the host sample rate once per rate, shared by instances
  *
  * Parameters:
  * - preset: 0-5 (Room, Studio S/M/L, Hall, Space Echo)
  * - decay: Wall reflection feedback scaling (0.0-1.0)
  * - mix: Dry/wet blend (0.0-1.0)
+ * - input_gain, reverb_level: SPU input/output volume scaling (0.0-1.0)
+ * - crossfade: Preset change crossfade (0-2000 ms)
+ * - engine: Float (reference) or Fixed (Q15 saturating, SPU-style)
+ * - routing: Insert (dry/wet), Wet (send/return) or Mono (summed input, wet)
+ * - freeze: Off, Loop or Reverse (replay the tail, input ignored)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 
 #include "audio_fx_api_v1.h"
 
@@ -28,6 +41,18 @@
 #define AUDIO_FX_API_VERSION_2 2
 #define AUDIO_FX_INIT_V2_SYMBOL "move_audio_fx_init_v2"
 
+/* Extended v2: process_block_f32 follows the v2 members. Reported only to
+ * hosts that announce float support through host_api_v1_t.api_version, so
+ * hosts expecting exactly version 2 keep loading the module; the member is
+ * filled in either way. */
+#define AUDIO_FX_API_VERSION_2_F32 3
+#define HOST_API_VERSION_F32 2
+
+/* Extended again: process_block_multi follows process_block_f32, on the
+ * same terms (see MULTI-BUS) */
+#define AUDIO_FX_API_VERSION_2_MULTI 4
+#define HOST_API_VERSION_MULTI 3
+
 typedef struct audio_fx_api_v2 {
     uint32_t api_version;
     void* (*create_instance)(const char *module_dir, const char *config_json);
@@ -35,139 +60,377 @@ typedef struct audio_fx_api_v2 {
     void (*process_block)(void *instance, int16_t *audio_inout, int frames);
     void (*set_param)(void *instance, const char *key, const char *val);
     int (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+    /* AUDIO_FX_API_VERSION_2_F32: in-place float, full scale 1.0, unclamped.
+     * Planar: (l, r, 1, frames); interleaved: (buf, buf + 1, 2, frames). */
+    void (*process_block_f32)(void *instance, float *left, float *right, int stride, int frames);
+    /* AUDIO_FX_API_VERSION_2_MULTI: `buses` interleaved int16 buffers, each
+     * processed in place like process_block */
+    void (*process_block_multi)(void *instance, int16_t *const *audio_inout, int buses, int frames);
 } audio_fx_api_v2_t;
 
 typedef audio_fx_api_v2_t* (*audio_fx_init_v2_fn)(const host_api_v1_t *host);
 
-#define SAMPLE_RATE 48000       /* Move hardware sample rate */
 #define PSX_NATIVE_RATE 44100   /* PSX native sample rate */
 #define PSX_INTERNAL_RATE 22050 /* PSX SPU runs at half sample rate */
-#define RATE_SCALE ((float)SAMPLE_RATE / (float)PSX_NATIVE_RATE)  /* ~1.088 */
+#define MIN_SAMPLE_RATE 22050   /* Host rates accepted at create time */
+#define MAX_SAMPLE_RATE 96000
+
+/* Build with -DPSXVERB_PROFILE=1 for the perf_stats/perf_reset params.
+ * Disabled, every counter below compiles out. */
+#ifndef PSXVERB_PROFILE
+#define PSXVERB_PROFILE 0
+#endif
+
+#if PSXVERB_PROFILE
+/* Per-call event counts, collected after every process_block */
+static _Thread_local uint32_t t_perf_saturations;  /* Work area writes clipped to int16 */
+static _Thread_local uint32_t t_perf_clips;        /* Output samples clamped to [-1, 1] */
+#define PERF_COUNT(counter, cond) do { if (cond) (counter)++; } while (0)
+#else
+#define PERF_COUNT(counter, cond) do { } while (0)
+#endif
 
 /* ============================================================================
  * HALFBAND 39-TAP FIR FILTER
- * Exact port from Halfband39.h
+ * Polyphase form of Halfband39.h
+ *
+ * The reference kernel is 39 taps long with exact zeros at every odd index
+ * except the center (19). Split into polyphase branches at the low rate:
+ * - Phase A: the 20 even-index taps, symmetric, so 10 pre-added pairs
+ * - Phase B: the center tap alone, i.e. a pure 9-tick delay
+ * The decimator sums both branches; the interpolator emits phase A as its
+ * first output sample and phase B as its second, which is exactly what a
+ * zero-stuffed 39-tap convolution yields, without multiplying the zeros.
  * ============================================================================ */
 
 #define HB_TAPS 39
-#define HB_STATE_SIZE 64  /* Power of 2 >= 39 */
-#define HB_STATE_MASK 63  /* 0x3F for fast wrap */
-
-/* Halfband FIR coefficients - EXACT from reference Halfband39.h */
-static const float g_hb_coeffs[HB_TAPS] = {
-    -0.000275135f,  /* 0 */
-     0.0f,          /* 1 */
-    -0.001467466f,  /* 2 */
-     0.0f,          /* 3 */
-    -0.004356503f,  /* 4 */
-     0.0f,          /* 5 */
-    -0.009765625f,  /* 6 */
-     0.0f,          /* 7 */
-    -0.018493652f,  /* 8 */
-     0.0f,          /* 9 */
-    -0.031494141f,  /* 10 */
-     0.0f,          /* 11 */
-    -0.050598145f,  /* 12 */
-     0.0f,          /* 13 */
-    -0.079833984f,  /* 14 */
-     0.0f,          /* 15 */
-    -0.130859375f,  /* 16 */
-     0.0f,          /* 17 */
-    -0.281494141f,  /* 18 */
-     0.632812500f,  /* 19 - CENTER TAP */
-    -0.281494141f,  /* 20 */
-     0.0f,          /* 21 */
-    -0.130859375f,  /* 22 */
-     0.0f,          /* 23 */
-    -0.079833984f,  /* 24 */
-     0.0f,          /* 25 */
-    -0.050598145f,  /* 26 */
-     0.0f,          /* 27 */
-    -0.031494141f,  /* 28 */
-     0.0f,          /* 29 */
-    -0.018493652f,  /* 30 */
-     0.0f,          /* 31 */
-    -0.009765625f,  /* 32 */
-     0.0f,          /* 33 */
-    -0.004356503f,  /* 34 */
-     0.0f,          /* 35 */
-    -0.001467466f,  /* 36 */
-     0.0f,          /* 37 */
-    -0.000275135f,  /* 38 */
-};
+#define HB_PAIRS 10          /* Symmetric non-zero tap pairs */
+#define HB_PHASE_TAPS 20     /* Even-index taps = low-rate history length */
+#define HB_CENTER_DELAY 9    /* Center tap delay in low-rate ticks */
+#define HB_RING_SIZE 32      /* Power of 2 >= HB_PHASE_TAPS */
+#define HB_RING_MASK 31
 
-/* Polyphase Phase 0: coeffs at even indices [0, 2, 4, ..., 38] */
-static const float g_hb_phase0[20] = {
-    -0.000275135f, -0.001467466f, -0.004356503f, -0.009765625f,
-    -0.018493652f, -0.031494141f, -0.050598145f, -0.079833984f,
-    -0.130859375f, -0.281494141f,  0.632812500f, -0.281494141f,
-    -0.130859375f, -0.079833984f, -0.050598145f, -0.031494141f,
-    -0.018493652f, -0.009765625f, -0.004356503f, -0.001467466f
+/* Halfband FIR coefficients - EXACT from reference Halfband39.h.
+ * Even indices [0, 2, ..., 18]; [20, ..., 38] mirror them and every odd
+ * index other than the center is 0.0f. */
+static const float g_hb_pair_coeffs[HB_PAIRS] = {
+    -0.000275135f,  /* 0, 38 */
+    -0.001467466f,  /* 2, 36 */
+    -0.004356503f,  /* 4, 34 */
+    -0.009765625f,  /* 6, 32 */
+    -0.018493652f,  /* 8, 30 */
+    -0.031494141f,  /* 10, 28 */
+    -0.050598145f,  /* 12, 26 */
+    -0.079833984f,  /* 14, 24 */
+    -0.130859375f,  /* 16, 22 */
+    -0.281494141f,  /* 18, 20 */
 };
+static const float g_hb_center = 0.632812500f;  /* 19 - CENTER TAP */
 
-/* Polyphase Phase 1: coeffs at odd indices (all zeros for halfband) */
-static const float g_hb_phase1[19] = {
-    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f
+/* Short 11-tap halfband for the "11-tap" resampler: Kaiser (beta 3)
+ * windowed sinc, unity DC gain, -35 dB at 0.35 fs and -45 dB from 0.4 fs.
+ * Same polyphase layout: even indices [0, 2, 4] mirrored, center at 5. */
+#define HB11_PAIRS 3
+#define HB11_CENTER_DELAY 2
+static const float g_hb11_pair_coeffs[HB11_PAIRS] = {
+    0.013050815f,   /* 0, 10 */
+    -0.066325472f,  /* 2, 8 */
+    0.303274657f,   /* 4, 6 */
 };
+static const float g_hb11_center = 0.5f;
 
+/* NEON path for ARM64 (Move). Define PSXVERB_NO_NEON to force the scalar
+ * fallback, e.g. when comparing the two paths on the same target. */
+#if defined(__ARM_NEON) && !defined(PSXVERB_NO_NEON)
+#define PSXVERB_USE_NEON 1
+#include <arm_neon.h>
+#else
+#define PSXVERB_USE_NEON 0
+#endif
+
+/* Stereo low-rate history: L/R interleaved in a mirrored ring.
+ * Every frame is written twice (at pos and pos + HB_RING_SIZE), so the
+ * HB_PHASE_TAPS (or fewer, for the short kernel) most recent frames are
+ * always contiguous starting at pos, newest first, and both channels are
+ * filtered in one pass. */
 typedef struct {
-    float state[HB_STATE_SIZE];
-    int pos;
-} halfband_t;
+    float state[2 * HB_RING_SIZE * 2];  /* [frame][L,R], mirrored */
+    int pos;                             /* Newest frame */
+} hb_ring_t;
 
-static void halfband_init(halfband_t *hb) {
-    memset(hb->state, 0, sizeof(hb->state));
-    hb->pos = 0;
+static void hb_ring_init(hb_ring_t *r) {
+    memset(r->state, 0, sizeof(r->state));
+    r->pos = 0;
 }
 
-/* Decimate: 44.1kHz -> 22.05kHz (2 samples in, 1 out)
- * Exact port from Halfband39::Decimate */
-static float halfband_decimate(halfband_t *hb, float x0, float x1) {
-    /* Push two new samples */
-    hb->state[hb->pos] = x0;
-    hb->pos = (hb->pos + 1) & HB_STATE_MASK;  /* wrap at 64 */
-    hb->state[hb->pos] = x1;
-    hb->pos = (hb->pos + 1) & HB_STATE_MASK;
+/* Push one stereo frame (newest first, so pos walks backwards) */
+static inline void hb_ring_push(hb_ring_t *r, float l, float rr) {
+    r->pos = (r->pos - 1) & HB_RING_MASK;
+    float *a = &r->state[r->pos * 2];
+    float *b = &r->state[(r->pos + HB_RING_SIZE) * 2];
+    a[0] = l; a[1] = rr;
+    b[0] = l; b[1] = rr;
+}
 
-    /* Convolve with ALL 39 taps (CRITICAL: must process all taps to prevent aliasing) */
-    float sum = 0.0f;
-    int idx = hb->pos;
-    for (int i = 0; i < HB_TAPS; ++i) {
-        idx = (idx - 1) & HB_STATE_MASK;
-        sum += g_hb_coeffs[i] * hb->state[idx];
+/* Frame pushed `delay` ticks ago as {L, R} */
+static inline const float *hb_ring_tap(const hb_ring_t *r, int delay) {
+    return &r->state[(r->pos + delay) * 2];
+}
+
+/* The kernels below take the coefficient set as arguments and are always
+ * inlined with constants (see the RESAMPLERS section), so each filter
+ * length compiles to its own fully unrolled loop. */
+#define HB_INLINE static inline __attribute__((always_inline))
+
+/* Phase A: sum of c[j] * (w[j] + w[2 * pairs - 1 - j]) over the symmetric pairs */
+HB_INLINE void hb_phase_a(const hb_ring_t *r, const float *coeffs, int pairs,
+                          float *out_l, float *out_r) {
+    const float *w = hb_ring_tap(r, 0);
+    const int taps = pairs * 2;
+#if PSXVERB_USE_NEON
+    /* Two pairs per iteration: front frames {j, j+1} against back frames
+     * {taps-1-j, taps-2-j}, lanes {L, R, L, R} */
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    int j = 0;
+    for (; j + 2 <= pairs; j += 2) {
+        float32x4_t front = vld1q_f32(&w[j * 2]);
+        float32x4_t back = vld1q_f32(&w[(taps - 2 - j) * 2]);
+        back = vextq_f32(back, back, 2);
+        float32x2_t c = vld1_f32(&coeffs[j]);
+        float32x4_t cc = vcombine_f32(vdup_lane_f32(c, 0), vdup_lane_f32(c, 1));
+        acc = vfmaq_f32(acc, cc, vaddq_f32(front, back));
     }
-    return sum;
+    float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float sum_l = vget_lane_f32(sum, 0);
+    float sum_r = vget_lane_f32(sum, 1);
+    for (; j < pairs; ++j) {
+        const float *a = &w[j * 2];
+        const float *b = &w[(taps - 1 - j) * 2];
+        sum_l += coeffs[j] * (a[0] + b[0]);
+        sum_r += coeffs[j] * (a[1] + b[1]);
+    }
+    *out_l = sum_l;
+    *out_r = sum_r;
+#else
+    float sum_l = 0.0f, sum_r = 0.0f;
+    for (int j = 0; j < pairs; ++j) {
+        const float *a = &w[j * 2];
+        const float *b = &w[(taps - 1 - j) * 2];
+        sum_l += coeffs[j] * (a[0] + b[0]);
+        sum_r += coeffs[j] * (a[1] + b[1]);
+    }
+    *out_l = sum_l;
+    *out_r = sum_r;
+#endif
 }
 
-/* Interpolate: 22.05kHz -> 44.1kHz (1 sample in, 2 out)
- * Exact port from Halfband39::Interpolate */
-static void halfband_interpolate(halfband_t *hb, float in_tick, float *out_s0, float *out_s1) {
-    /* Push upsampled input (zero-stuff: [in, 0]) */
-    hb->state[hb->pos] = in_tick;
-    hb->pos = (hb->pos + 1) & HB_STATE_MASK;
+/* Minimum-phase alternative for the "IIR" resampler: a polyphase allpass
+ * halfband. Two branches of first-order allpasses (a + z^-1) / (1 + a z^-1)
+ * at the low rate, i.e. (a + z^-2) / (1 + a z^-2) seen from the high rate,
+ * with the coefficients alternating between the branches. Elliptic design
+ * with six coefficients and a 0.04 fs transition: flat to 0.21 fs, -74 dB
+ * from 0.29 fs, about 2.7 high-rate samples of group delay at DC (19 for
+ * the 39-tap FIR) and three multiplies per channel per tick. Not linear
+ * phase: the delay rises to about 3.3 samples at 0.1 fs.
+ * Lanes are {branch 0 L, branch 0 R, branch 1 L, branch 1 R}. */
+#define IIR_HB_SECTIONS 3    /* Allpass sections per branch */
 
-    /* Phase 0: even coefficients (produces sample 0) */
-    float sum0 = 0.0f;
-    int idx = hb->pos;
-    for (int i = 0; i < 20; ++i) {  /* 20 even taps */
-        idx = (idx - 1) & HB_STATE_MASK;
-        sum0 += g_hb_phase0[i] * hb->state[idx];
+/* Offset added to every allpass input. It passes at unity, so once a tail
+ * has decayed the state settles on it instead of running down through the
+ * subnormal range; far below float resolution of any audible sample, and
+ * rounded away by the int16 conversions. See DENORMAL GUARD. */
+#define DENORMAL_DC 1e-18f
+
+static const float g_iir_hb_coeffs[IIR_HB_SECTIONS][4] = {
+    {0.068204076f, 0.068204076f, 0.240270358f, 0.240270358f},
+    {0.448676236f, 0.448676236f, 0.641122367f, 0.641122367f},
+    {0.799997564f, 0.799997564f, 0.934482236f, 0.934482236f},
+};
+
+/* mem[0] is each branch's previous input, mem[k + 1] the previous output of
+ * section k, which is also the previous input of section k + 1 */
+typedef struct {
+    float mem[IIR_HB_SECTIONS + 1][4];
+} iir_hb_t;
+
+/* Run both branches over x in place. lanes is 4 (stereo) or 2 (mono, lanes
+ * {branch 0, branch 1} using the first half of each row). */
+HB_INLINE void iir_hb_branches(iir_hb_t *s, float *x, int lanes) {
+#if PSXVERB_USE_NEON
+    if (lanes == 4) {
+        float32x4_t v = vld1q_f32(x);
+        for (int k = 0; k < IIR_HB_SECTIONS; ++k) {
+            float32x4_t in1 = vld1q_f32(s->mem[k]);
+            float32x4_t out1 = vld1q_f32(s->mem[k + 1]);
+            vst1q_f32(s->mem[k], v);
+            v = vfmaq_f32(in1, vsubq_f32(v, out1), vld1q_f32(g_iir_hb_coeffs[k]));
+        }
+        vst1q_f32(s->mem[IIR_HB_SECTIONS], v);
+        vst1q_f32(x, v);
+        return;
+    }
+#endif
+    for (int k = 0; k < IIR_HB_SECTIONS; ++k) {
+        for (int i = 0; i < lanes; ++i) {
+            float y = (x[i] - s->mem[k + 1][i]) * g_iir_hb_coeffs[k][i * (4 / lanes)] +
+                      s->mem[k][i];
+            s->mem[k][i] = x[i];
+            x[i] = y;
+        }
     }
+    for (int i = 0; i < lanes; ++i) s->mem[IIR_HB_SECTIONS][i] = x[i];
+}
+
+/* Stereo 2:1 decimator: phase A runs on the second sample of each input
+ * pair, phase B (center tap) on the first */
+typedef struct {
+    hb_ring_t even;   /* Second sample of each pair */
+    hb_ring_t odd;    /* First sample of each pair, center-tap delay line */
+    iir_hb_t iir;     /* "IIR" resampler state */
+} hb_decimator_t;
+
+/* Stereo 1:2 interpolator: both phases share the low-rate history */
+typedef struct {
+    hb_ring_t hist;
+    iir_hb_t iir;
+} hb_interpolator_t;
+
+static void hb_decimator_init(hb_decimator_t *d) {
+    hb_ring_init(&d->even);
+    hb_ring_init(&d->odd);
+    memset(&d->iir, 0, sizeof(d->iir));
+}
 
-    /* Phase 1: odd coefficients (produces sample 1) */
-    hb->state[hb->pos] = 0.0f;  /* zero-stuffed sample */
-    hb->pos = (hb->pos + 1) & HB_STATE_MASK;
+static void hb_interpolator_init(hb_interpolator_t *u) {
+    hb_ring_init(&u->hist);
+    memset(&u->iir, 0, sizeof(u->iir));
+}
+
+/* Decimate with the allpass pair: the second sample of each input pair
+ * feeds branch 0, the first feeds branch 1, and the output is their mean */
+HB_INLINE void iir_halfband_decimate(iir_hb_t *s, float l0, float r0, float l1, float r1,
+                                     float *out_l, float *out_r) {
+    float x[4] = {l1 + DENORMAL_DC, r1 + DENORMAL_DC, l0 + DENORMAL_DC, r0 + DENORMAL_DC};
+    iir_hb_branches(s, x, 4);
+    *out_l = (x[0] + x[2]) * 0.5f;
+    *out_r = (x[1] + x[3]) * 0.5f;
+}
+
+/* Interpolate: every tick drives both branches, branch 0 gives the first
+ * output sample and branch 1 the second (unity gain, no zero-stuffing) */
+HB_INLINE void iir_halfband_interpolate(iir_hb_t *s, float in_l, float in_r,
+                                        float *out_l0, float *out_r0,
+                                        float *out_l1, float *out_r1) {
+    float x[4] = {in_l + DENORMAL_DC, in_r + DENORMAL_DC, in_l + DENORMAL_DC, in_r + DENORMAL_DC};
+    iir_hb_branches(s, x, 4);
+    *out_l0 = x[0];
+    *out_r0 = x[1];
+    *out_l1 = x[2];
+    *out_r1 = x[3];
+}
+
+/* Decimate: 44.1kHz -> 22.05kHz (2 frames in, 1 out) for both channels
+ * With the 39-tap set, equivalent to the full Halfband39::Decimate convolution */
+HB_INLINE void halfband_decimate(hb_decimator_t *d, const float *coeffs, int pairs,
+                                 float center, int center_delay,
+                                 float l0, float r0, float l1, float r1,
+                                 float *out_l, float *out_r) {
+    hb_ring_push(&d->odd, l0, r0);
+    hb_ring_push(&d->even, l1, r1);
+
+    float l, r;
+    hb_phase_a(&d->even, coeffs, pairs, &l, &r);
+    const float *c = hb_ring_tap(&d->odd, center_delay);
+    *out_l = l + center * c[0];
+    *out_r = r + center * c[1];
+}
+
+/* Interpolate: 22.05kHz -> 44.1kHz (1 frame in, 2 out) for both channels
+ * With the 39-tap set, equivalent to Halfband39::Interpolate over the
+ * zero-stuffed stream */
+HB_INLINE void halfband_interpolate(hb_interpolator_t *u, const float *coeffs, int pairs,
+                                    float center, int center_delay,
+                                    float in_l, float in_r,
+                                    float *out_l0, float *out_r0,
+                                    float *out_l1, float *out_r1) {
+    hb_ring_push(&u->hist, in_l, in_r);
+
+    /* Phase A (produces sample 0) */
+    float l, r;
+    hb_phase_a(&u->hist, coeffs, pairs, &l, &r);
+    *out_l0 = l * 2.0f;  /* Compensate for zero-stuffing */
+    *out_r0 = r * 2.0f;
+
+    /* Phase B: delayed center tap (produces sample 1) */
+    const float *c = hb_ring_tap(&u->hist, center_delay);
+    *out_l1 = c[0] * (center * 2.0f);
+    *out_r1 = c[1] * (center * 2.0f);
+}
+
+/* Mono low-rate history for the summed-input decimator, mirrored like
+ * hb_ring_t: the newest HB_PHASE_TAPS samples are contiguous from pos */
+typedef struct {
+    float state[2 * HB_RING_SIZE];
+    int pos;
+} hb_mono_ring_t;
+
+typedef struct {
+    hb_mono_ring_t even;
+    hb_mono_ring_t odd;
+    iir_hb_t iir;
+} hb_mono_decimator_t;
+
+static void hb_mono_decimator_init(hb_mono_decimator_t *d) {
+    memset(d, 0, sizeof(*d));
+}
+
+static inline void hb_mono_ring_push(hb_mono_ring_t *r, float x) {
+    r->pos = (r->pos - 1) & HB_RING_MASK;
+    r->state[r->pos] = x;
+    r->state[r->pos + HB_RING_SIZE] = x;
+}
 
-    float sum1 = 0.0f;
-    idx = hb->pos;
-    for (int i = 0; i < 19; ++i) {  /* 19 odd taps */
-        idx = (idx - 1) & HB_STATE_MASK;
-        sum1 += g_hb_phase1[i] * hb->state[idx];
+/* Phase A on one channel: four pairs per NEON iteration, the rest scalar */
+HB_INLINE float hb_mono_phase_a(const hb_mono_ring_t *r, const float *coeffs, int pairs) {
+    const float *w = &r->state[r->pos];
+    const int taps = pairs * 2;
+#if PSXVERB_USE_NEON
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (int j = 0; j + 4 <= pairs; j += 4) {
+        float32x4_t front = vld1q_f32(&w[j]);
+        float32x4_t back = vld1q_f32(&w[taps - 4 - j]);
+        back = vrev64q_f32(back);
+        back = vextq_f32(back, back, 2);
+        acc = vfmaq_f32(acc, vld1q_f32(&coeffs[j]), vaddq_f32(front, back));
+    }
+    float sum = vaddvq_f32(acc);
+    for (int j = pairs & ~3; j < pairs; ++j) {
+        sum += coeffs[j] * (w[j] + w[taps - 1 - j]);
+    }
+    return sum;
+#else
+    float sum = 0.0f;
+    for (int j = 0; j < pairs; ++j) {
+        sum += coeffs[j] * (w[j] + w[taps - 1 - j]);
     }
+    return sum;
+#endif
+}
+
+/* Decimate one channel: half the work of halfband_decimate */
+HB_INLINE float halfband_decimate_mono(hb_mono_decimator_t *d, const float *coeffs, int pairs,
+                                       float center, int center_delay, float x0, float x1) {
+    hb_mono_ring_push(&d->odd, x0);
+    hb_mono_ring_push(&d->even, x1);
+    return hb_mono_phase_a(&d->even, coeffs, pairs) +
+           center * d->odd.state[d->odd.pos + center_delay];
+}
 
-    *out_s0 = sum0 * 2.0f;  /* Compensate for zero-stuffing */
-    *out_s1 = sum1 * 2.0f;
+/* Allpass-pair decimator on one channel, two lanes */
+HB_INLINE float iir_halfband_decimate_mono(iir_hb_t *s, float x0, float x1) {
+    float x[2] = {x1 + DENORMAL_DC, x0 + DENORMAL_DC};
+    iir_hb_branches(s, x, 2);
+    return (x[0] + x[1]) * 0.5f;
 }
 
 /* ============================================================================
@@ -175,18 +438,40 @@ static void halfband_interpolate(halfband_t *hb, float in_tick, float *out_s0, f
  * Exact port from WorkArea.h
  * ============================================================================ */
 
-#define WORK_MAX_SIZE 65536  /* Maximum work area size */
+#define WORK_MAX_SIZE 131072 /* Maximum work area size (Space Echo at 96kHz) */
+#define WORK_ALIGN 64        /* Cache line size on Cortex-A72 */
+#define WORK_GUARD 64        /* Mirrored samples past the end, >= ticks per kernel call */
 
 /* Conversion constants - exact from WorkArea.h */
 static const float kInt16ToFloat = 1.0f / 32768.0f;
 static const float kFloatToInt16 = 32768.0f;
 
+/* buf holds size + WORK_GUARD samples; buf[size + i] mirrors buf[i] for
+ * i < WORK_GUARD. A tap resolved once at the start of a kernel call can
+ * then be read linearly for up to WORK_GUARD ticks without wrapping. */
 typedef struct {
     int16_t *buf;
     uint32_t size_mask;  /* size - 1, for fast wrap with & */
     uint32_t base;       /* Current base position (advances each tick) */
 } workarea_t;
 
+/* Store at an absolute position < size + WORK_GUARD, keeping the guard in sync */
+static inline void workarea_store(workarea_t *wa, uint32_t pos, int16_t value) {
+    pos &= wa->size_mask;
+    wa->buf[pos] = value;
+    if (pos < WORK_GUARD) wa->buf[pos + wa->size_mask + 1] = value;
+}
+
+/* Float -> int16 with 16-bit saturation, as in WorkArea::WriteRelative */
+static inline int16_t workarea_sat(float value) {
+    int32_t val_int = (int32_t)(value * kFloatToInt16);
+    PERF_COUNT(t_perf_saturations, val_int > 32767 || val_int < -32768);
+    /* Saturate to int16 range [-32768, 32767] */
+    if (val_int > 32767) val_int = 32767;
+    if (val_int < -32768) val_int = -32768;
+    return (int16_t)val_int;
+}
+
 
 /* Read at relative offset from current base (for IIR: base - 1)
  * Exact port from WorkArea::ReadRelative */
@@ -198,12 +483,23 @@ static inline float workarea_read_relative(const workarea_t *wa, int32_t offset)
 /* Write at relative offset from current base with 16-bit saturation
  * Exact port from WorkArea::WriteRelative */
 static inline void workarea_write_relative(workarea_t *wa, int32_t offset, float value) {
-    int32_t val_int = (int32_t)(value * kFloatToInt16);
-    /* Saturate to int16 range [-32768, 32767] */
-    if (val_int > 32767) val_int = 32767;
-    if (val_int < -32768) val_int = -32768;
-    uint32_t idx = (wa->base + offset) & wa->size_mask;
-    wa->buf[idx] = (int16_t)val_int;
+    workarea_store(wa, wa->base + offset, workarea_sat(value));
+}
+
+/* Raw int16 access for the fixed-point engine (no float conversion) */
+static inline int16_t workarea_read_q15(const workarea_t *wa, int32_t offset) {
+    return wa->buf[(wa->base + offset) & wa->size_mask];
+}
+
+/* Saturation already happened in the Q15 ops; a value at either int16 limit
+ * is counted as saturated */
+static inline void workarea_write_q15_at(workarea_t *wa, uint32_t pos, int16_t value) {
+    PERF_COUNT(t_perf_saturations, value == 32767 || value == -32768);
+    workarea_store(wa, pos, value);
+}
+
+static inline void workarea_write_q15(workarea_t *wa, int32_t offset, int16_t value) {
+    workarea_write_q15_at(wa, wa->base + offset, value);
 }
 
 /* Advance base pointer (called once per tick)
@@ -256,7 +552,9 @@ typedef struct {
 } psx_preset_t;
 
 /* PSX SPU Reverb Presets - EXACT hex values from PsxPreset.h */
-static const psx_preset_t g_presets[6] = {
+#define PRESET_COUNT 6      /* Built-in presets; a preset bank adds more */
+
+static const psx_preset_t g_presets[PRESET_COUNT] = {
     /* Room - exact from PsxPresets::kRoom */
     {
         .dAPF1 = 0x007D, .dAPF2 = 0x005B,
@@ -396,6 +694,27 @@ static const psx_preset_t g_presets[6] = {
  * Matches PsxReverb.h ScaledPreset struct
  * ============================================================================ */
 
+/* Tap program: every work area access of one SPU tick as an offset from
+ * base, in kernel order, pre-wrapped to the preset's work area size and with
+ * the derived taps (m - 1, mAPF - dAPF) folded in. Reads and writes of each
+ * stage are grouped so a stage's four lanes sit together. */
+enum {
+    TAP_FB,                 /* dLSAME, dRSAME, dRDIFF, dLDIFF */
+    TAP_HIST = TAP_FB + 4,  /* mLSAME-1, mRSAME-1, mLDIFF-1, mRDIFF-1 */
+    TAP_REFL = TAP_HIST + 4,/* mLSAME, mRSAME, mLDIFF, mRDIFF (writes) */
+    TAP_COMB = TAP_REFL + 4,/* mLCOMB1, mRCOMB1, ..., mLCOMB4, mRCOMB4 */
+    TAP_APF_DEL = TAP_COMB + 8, /* mLAPF1-dAPF1, mRAPF1-dAPF1, mLAPF2-dAPF2, mRAPF2-dAPF2 */
+    TAP_APF = TAP_APF_DEL + 4,  /* mLAPF1, mRAPF1, mLAPF2, mRAPF2 (writes) */
+    TAP_COUNT = TAP_APF + 4
+};
+
+typedef struct {
+    uint32_t off[TAP_COUNT];
+    uint32_t lookahead;     /* Ticks the multi-tick kernel may batch (see build_taps) */
+    uint32_t comb_early;    /* Comb taps it reads before the reflections, bit per TAP_COMB + i */
+    uint32_t diff_dead;     /* DIFF reflection never reaches the output (see taps_diff_dead) */
+} spu_taps_t;
+
 typedef struct {
     uint16_t dAPF1, dAPF2;
     uint16_t dLSAME, dRSAME, dLDIFF, dRDIFF;
@@ -406,6 +725,7 @@ typedef struct {
     float vIIR_f, vCOMB1_f, vCOMB2_f, vCOMB3_f, vCOMB4_f;
     float vWALL_f, vAPF1_f, vAPF2_f, vLIN_f, vRIN_f;
     float vLOUT_f, vROUT_f;
+    spu_taps_t taps;
 } scaled_preset_t;
 
 /* ============================================================================
@@ -458,68 +778,226 @@ static inline float max_f(float a, float b) {
     return a > b ? a : b;
 }
 
-/* Helper to extract a JSON number value by key */
-static int json_get_number(const char *json, const char *key, float *out) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *pos = strstr(json, search);
-    if (!pos) return -1;
-    pos += strlen(search);
-    while (*pos == ' ') pos++;
-    *out = (float)atof(pos);
-    return 0;
+/* Min of two floats */
+static inline float min_f(float a, float b) {
+    return a < b ? a : b;
 }
 
 /* ============================================================================
- * AUDIO FX API v2 - Instance-based
+ * PRESET BANK
+ * Extra SPU register dumps (e.g. from game rips) load from presets.bank next
+ * to module.json. The file is mapped read-only on the first create_instance,
+ * validated once and appended to the built-in presets; every rate table then
+ * scales the whole list. A bank that fails validation is ignored as a whole.
+ *
+ * Layout, little-endian: a 16-byte header followed by `count` 96-byte
+ * records. A record holds the 32 reverb registers in SPU order
+ * (0x1F801DC0-0x1F801DFE), vLOUT/vROUT, the work area size in bytes and a
+ * NUL-padded name, all in the units of g_presets. scripts/mkbank.py writes it.
  * ============================================================================ */
 
+#define PRESET_BANK_FILE "presets.bank"
+#define PRESET_BANK_VERSION 1
+#define PRESET_BANK_MAX 1024            /* Bank entries accepted */
+#define PRESET_BANK_WORK_MAX 0x10000u   /* Bytes; fits WORK_MAX_SIZE at MAX_SAMPLE_RATE */
+#define PRESET_NAME_LEN 24
+
 typedef struct {
-    int16_t *work_buffer;
-    int preset_idx;
-    float decay;
-    float mix;
-    float input_gain;
-    float reverb_level;
-    scaled_preset_t current;
-    scaled_preset_t base;
-    workarea_t work;
-    halfband_t down_l, down_r;
-    halfband_t up_l, up_r;
-} psxverb_instance_t;
+    char magic[4];          /* "PSXB" */
+    uint16_t version;
+    uint16_t count;
+    uint32_t record_size;   /* sizeof(preset_bank_record_t) */
+    uint32_t reserved;
+} preset_bank_header_t;
+
+typedef struct {
+    uint16_t reg[32];       /* dAPF1 ... vRIN */
+    int16_t vLOUT, vROUT;
+    uint32_t work_size;
+    char name[PRESET_NAME_LEN];
+} preset_bank_record_t;
+
+_Static_assert(sizeof(preset_bank_header_t) == 16, "preset bank header layout");
+_Static_assert(sizeof(preset_bank_record_t) == 96, "preset bank record layout");
+
+/* Built-ins first, then the bank. Fixed once the first instance exists. */
+static const psx_preset_t *g_preset_list = g_presets;
+static int g_preset_count = PRESET_COUNT;
+static int g_bank_tried = 0;
+static atomic_flag g_bank_lock = ATOMIC_FLAG_INIT;
+
+/* SPU register slots that hold coefficients rather than addresses */
+static int bank_reg_is_volume(int r) {
+    return (r >= 2 && r <= 9) || r >= 30;
+}
+
+/* Checks one record. Names must be printable and free of JSON quoting so
+ * they can go into chain_params as they are. */
+static int bank_record_valid(const preset_bank_record_t *rec) {
+    if (rec->work_size < 2 || rec->work_size > PRESET_BANK_WORK_MAX) return 0;
+    for (int r = 0; r < 32; r++) {
+        if (!bank_reg_is_volume(r) && rec->reg[r] >= rec->work_size / 2) return 0;
+    }
+    int len = 0;
+    while (len < PRESET_NAME_LEN && rec->name[len]) {
+        char c = rec->name[len++];
+        if (c < 0x20 || c > 0x7E || c == '"' || c == '\\') return 0;
+    }
+    return len > 0 && len < PRESET_NAME_LEN;
+}
+
+static void bank_record_decode(const preset_bank_record_t *rec, psx_preset_t *p) {
+    const uint16_t *r = rec->reg;
+    p->dAPF1 = r[0];   p->dAPF2 = r[1];
+    p->vIIR = (int16_t)r[2];
+    p->vCOMB1 = (int16_t)r[3]; p->vCOMB2 = (int16_t)r[4];
+    p->vCOMB3 = (int16_t)r[5]; p->vCOMB4 = (int16_t)r[6];
+    p->vWALL = (int16_t)r[7];
+    p->vAPF1 = (int16_t)r[8];  p->vAPF2 = (int16_t)r[9];
+    p->mLSAME = r[10];  p->mRSAME = r[11];
+    p->mLCOMB1 = r[12]; p->mRCOMB1 = r[13];
+    p->mLCOMB2 = r[14]; p->mRCOMB2 = r[15];
+    p->dLSAME = r[16];  p->dRSAME = r[17];
+    p->mLDIFF = r[18];  p->mRDIFF = r[19];
+    p->mLCOMB3 = r[20]; p->mRCOMB3 = r[21];
+    p->mLCOMB4 = r[22]; p->mRCOMB4 = r[23];
+    p->dLDIFF = r[24];  p->dRDIFF = r[25];
+    p->mLAPF1 = r[26];  p->mRAPF1 = r[27];
+    p->mLAPF2 = r[28];  p->mRAPF2 = r[29];
+    p->vLIN = (int16_t)r[30]; p->vRIN = (int16_t)r[31];
+    p->vLOUT = rec->vLOUT; p->vROUT = rec->vROUT;
+    p->work_size = rec->work_size;
+    p->name = rec->name;    /* Points into the mapping, which stays mapped */
+}
+
+/* Number of valid records in a mapped bank, or -1 */
+static int bank_validate(const uint8_t *data, size_t size) {
+    preset_bank_header_t h;
+    if (size < sizeof(h)) return -1;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, "PSXB", 4) != 0 || h.version != PRESET_BANK_VERSION ||
+        h.record_size != sizeof(preset_bank_record_t) || h.count > PRESET_BANK_MAX ||
+        size != sizeof(h) + (size_t)h.count * sizeof(preset_bank_record_t)) {
+        return -1;
+    }
+    const preset_bank_record_t *rec = (const preset_bank_record_t*)(data + sizeof(h));
+    for (int i = 0; i < h.count; i++) {
+        if (!bank_record_valid(&rec[i])) return -1;
+    }
+    return h.count;
+}
+
+/* Map module_dir/presets.bank and append it to the preset list.
+ * Caller holds g_bank_lock. */
+static void bank_load(const char *module_dir) {
+    char path[512];
+    struct stat st;
+    if (!module_dir || !module_dir[0]) return;
+    snprintf(path, sizeof(path), "%s/%s", module_dir, PRESET_BANK_FILE);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;     /* No bank: built-ins only */
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        fx_log("preset bank: cannot map " PRESET_BANK_FILE);
+        return;
+    }
+
+    int n = bank_validate((const uint8_t*)map, (size_t)st.st_size);
+    psx_preset_t *list = n > 0 ? (psx_preset_t*)malloc((PRESET_COUNT + (size_t)n) * sizeof(psx_preset_t))
+                               : NULL;
+    if (!list) {
+        fx_log(n < 0 ? "preset bank: invalid, ignored" : "preset bank: empty or out of memory");
+        munmap(map, (size_t)st.st_size);
+        return;
+    }
+    memcpy(list, g_presets, sizeof(g_presets));
+    const preset_bank_record_t *rec =
+        (const preset_bank_record_t*)((const uint8_t*)map + sizeof(preset_bank_header_t));
+    for (int i = 0; i < n; i++) bank_record_decode(&rec[i], &list[PRESET_COUNT + i]);
+    g_preset_list = list;
+    g_preset_count = PRESET_COUNT + n;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "preset bank: %d presets loaded", n);
+    fx_log(msg);
+}
+
+/* Load the bank on the first create_instance. Later calls, whatever their
+ * module_dir, see the same list: rate tables are built from it. */
+static void preset_list_init(const char *module_dir) {
+    while (atomic_flag_test_and_set_explicit(&g_bank_lock, memory_order_acquire)) {}
+    if (!g_bank_tried) {
+        g_bank_tried = 1;
+        bank_load(module_dir);
+    }
+    atomic_flag_clear_explicit(&g_bank_lock, memory_order_release);
+}
+
+/* Preset index for a name or a numeric string, -1 if neither */
+static int preset_find(const char *val) {
+    for (int i = 0; i < g_preset_count; i++) {
+        if (strcmp(val, g_preset_list[i].name) == 0) return i;
+    }
+    int idx = atoi(val);
+    return (idx >= 0 && idx < g_preset_count) ? idx : -1;
+}
+
+/* ============================================================================
+ * SAMPLE RATE TABLES
+ * Presets are authored at 44.1kHz. For each host rate in use, all presets are
+ * scaled once into a shared read-only table; loading a preset copies a
+ * ready-made scaled_preset_t instead of redoing the float math.
+ * ============================================================================ */
+
+#define RATE_TABLE_SLOTS 4   /* Distinct host rates cached per process */
+
+typedef struct {
+    int sample_rate;
+    scaled_preset_t *presets;   /* g_preset_count entries, never freed */
+    uint32_t *work_samples;     /* Work area size per preset */
+} rate_table_t;
+
+static rate_table_t g_rate_tables[RATE_TABLE_SLOTS];
+static int g_rate_table_count = 0;
+static atomic_flag g_rate_table_lock = ATOMIC_FLAG_INIT;
 
 /* Helper to scale delay value from 44.1kHz to actual sample rate */
-static inline uint16_t scale_delay(uint16_t delay) {
-    return (uint16_t)(delay * RATE_SCALE);
+static inline uint16_t scale_delay(uint16_t delay, float rate_scale) {
+    return (uint16_t)(delay * rate_scale);
 }
 
-/* v2 helper: scale preset with instance state - matches reference PsxReverb.h ScalePreset() */
-static void v2_scale_preset(psxverb_instance_t *inst, const psx_preset_t *src, scaled_preset_t *dst) {
-    /* Scale all delay offsets from 44.1kHz to 48kHz */
-    dst->dAPF1 = scale_delay(src->dAPF1);
-    dst->dAPF2 = scale_delay(src->dAPF2);
-    dst->dLSAME = scale_delay(src->dLSAME);
-    dst->dRSAME = scale_delay(src->dRSAME);
-    dst->dLDIFF = scale_delay(src->dLDIFF);
-    dst->dRDIFF = scale_delay(src->dRDIFF);
+/* Scale preset to a sample rate - matches reference PsxReverb.h ScalePreset() */
+static void scale_preset(const psx_preset_t *src, float rate_scale, scaled_preset_t *dst) {
+    /* Scale all delay offsets from 44.1kHz to the host rate */
+    dst->dAPF1 = scale_delay(src->dAPF1, rate_scale);
+    dst->dAPF2 = scale_delay(src->dAPF2, rate_scale);
+    dst->dLSAME = scale_delay(src->dLSAME, rate_scale);
+    dst->dRSAME = scale_delay(src->dRSAME, rate_scale);
+    dst->dLDIFF = scale_delay(src->dLDIFF, rate_scale);
+    dst->dRDIFF = scale_delay(src->dRDIFF, rate_scale);
 
     /* Scale all memory addresses */
-    dst->mLSAME = scale_delay(src->mLSAME);
-    dst->mRSAME = scale_delay(src->mRSAME);
-    dst->mLDIFF = scale_delay(src->mLDIFF);
-    dst->mRDIFF = scale_delay(src->mRDIFF);
-    dst->mLCOMB1 = scale_delay(src->mLCOMB1);
-    dst->mRCOMB1 = scale_delay(src->mRCOMB1);
-    dst->mLCOMB2 = scale_delay(src->mLCOMB2);
-    dst->mRCOMB2 = scale_delay(src->mRCOMB2);
-    dst->mLCOMB3 = scale_delay(src->mLCOMB3);
-    dst->mRCOMB3 = scale_delay(src->mRCOMB3);
-    dst->mLCOMB4 = scale_delay(src->mLCOMB4);
-    dst->mRCOMB4 = scale_delay(src->mRCOMB4);
-    dst->mLAPF1 = scale_delay(src->mLAPF1);
-    dst->mRAPF1 = scale_delay(src->mRAPF1);
-    dst->mLAPF2 = scale_delay(src->mLAPF2);
-    dst->mRAPF2 = scale_delay(src->mRAPF2);
+    dst->mLSAME = scale_delay(src->mLSAME, rate_scale);
+    dst->mRSAME = scale_delay(src->mRSAME, rate_scale);
+    dst->mLDIFF = scale_delay(src->mLDIFF, rate_scale);
+    dst->mRDIFF = scale_delay(src->mRDIFF, rate_scale);
+    dst->mLCOMB1 = scale_delay(src->mLCOMB1, rate_scale);
+    dst->mRCOMB1 = scale_delay(src->mRCOMB1, rate_scale);
+    dst->mLCOMB2 = scale_delay(src->mLCOMB2, rate_scale);
+    dst->mRCOMB2 = scale_delay(src->mRCOMB2, rate_scale);
+    dst->mLCOMB3 = scale_delay(src->mLCOMB3, rate_scale);
+    dst->mRCOMB3 = scale_delay(src->mRCOMB3, rate_scale);
+    dst->mLCOMB4 = scale_delay(src->mLCOMB4, rate_scale);
+    dst->mRCOMB4 = scale_delay(src->mRCOMB4, rate_scale);
+    dst->mLAPF1 = scale_delay(src->mLAPF1, rate_scale);
+    dst->mRAPF1 = scale_delay(src->mRAPF1, rate_scale);
+    dst->mLAPF2 = scale_delay(src->mLAPF2, rate_scale);
+    dst->mRAPF2 = scale_delay(src->mRAPF2, rate_scale);
 
     /* Convert coefficients to float */
     dst->vIIR_f = coeff_to_float(src->vIIR);
@@ -536,344 +1014,3733 @@ static void v2_scale_preset(psxverb_instance_t *inst, const psx_preset_t *src, s
     dst->vROUT_f = coeff_to_float(src->vROUT);
 }
 
-/* v2 helper: update decay - adaptive formula from shared_dsp/PsxReverb.h
- * Automatically calculates safe maximum scale per preset to prevent oscillation.
- * - 0-50% decay maps to [0.5x, 1.0x] (below authentic to authentic PSX)
- * - 50-100% decay maps to [1.0x, maxScale] (authentic to maximum safe)
- * - Final value clamped to [-0.995, 0.995] to prevent runaway feedback
- */
-static void v2_update_decay(psxverb_instance_t *inst) {
-    float base = inst->base.vWALL_f;
-    if (base < 0) base = -base;  /* abs() */
-    if (base < 1e-5f) base = 1e-5f;  /* avoid div by zero */
+/* Safe lookahead for the multi-tick kernel (spu_run_multi).
+ * It runs a batch of ticks one group at a time: each group below operates on
+ * every tick of the batch before the next group starts. The only group that
+ * stays tick by tick is the reflection IIR, whose history tap reads the
+ * previous tick's write. Batching n ticks is exact unless two accesses in
+ * different groups, at least one a write, meet at the same address in the
+ * wrong order: a later group Y touching, D = 1..n-1 ticks earlier, what an
+ * earlier group X touches, or the same tick (D = 0) when Y precedes X in a
+ * tick. The lookahead is the smallest such D. Listed in original tick order.
+ *
+ * A comb read lands one tick after a reflection write whenever the comb tap
+ * sits right behind it (Hall), which would stop batching altogether. Such a
+ * read may instead run with the feedback reads, before the whole IIR: then
+ * it only has to stay clear of the writes ahead of it. tap_lookahead picks
+ * the placement per comb tap. With the DIFF reflection dead (Room) its taps
+ * are left out here and in the kernel. */
+static const struct {
+    uint8_t tap, group, write;
+} g_tap_schedule[TAP_COUNT] = {
+    {TAP_FB + 0, 0, 0}, {TAP_HIST + 0, 1, 0}, {TAP_REFL + 0, 1, 1},
+    {TAP_FB + 1, 0, 0}, {TAP_HIST + 1, 1, 0}, {TAP_REFL + 1, 1, 1},
+    {TAP_FB + 2, 0, 0}, {TAP_HIST + 2, 1, 0}, {TAP_REFL + 2, 1, 1},
+    {TAP_FB + 3, 0, 0}, {TAP_HIST + 3, 1, 0}, {TAP_REFL + 3, 1, 1},
+    {TAP_COMB + 0, 2, 0}, {TAP_COMB + 2, 2, 0}, {TAP_COMB + 4, 2, 0}, {TAP_COMB + 6, 2, 0},
+    {TAP_COMB + 1, 2, 0}, {TAP_COMB + 3, 2, 0}, {TAP_COMB + 5, 2, 0}, {TAP_COMB + 7, 2, 0},
+    {TAP_APF_DEL + 0, 3, 0}, {TAP_APF + 0, 4, 1}, {TAP_APF_DEL + 1, 5, 0}, {TAP_APF + 1, 6, 1},
+    {TAP_APF_DEL + 2, 7, 0}, {TAP_APF + 2, 8, 1}, {TAP_APF_DEL + 3, 9, 0}, {TAP_APF + 3, 10, 1},
+};
 
-    /* Calculate maximum safe scale for this preset */
-    float max_scale = 0.99f / base;
-    if (max_scale < 0.5f) max_scale = 0.5f;
-    if (max_scale > 10.0f) max_scale = 10.0f;
+static int tap_is_diff(int tap) {
+    return tap == TAP_FB + 2 || tap == TAP_FB + 3 || tap == TAP_HIST + 2 ||
+           tap == TAP_HIST + 3 || tap == TAP_REFL + 2 || tap == TAP_REFL + 3;
+}
 
-    float min_scale = 0.5f;
-    float mid_scale = 1.0f;  /* authentic PSX at 50% */
-    float mid_norm = 0.5f;
+/* Smallest conflicting D between schedule entry i and every other live
+ * entry, with entries placed in `group` */
+static uint32_t tap_entry_lookahead(const spu_taps_t *t, uint32_t work_samples,
+                                    const uint8_t *group, int i) {
+    uint32_t lookahead = work_samples;
+    for (int j = 0; j < TAP_COUNT; j++) {
+        if (group[j] == group[i]) continue;
+        if (!g_tap_schedule[i].write && !g_tap_schedule[j].write) continue;
+        if (t->diff_dead && tap_is_diff(g_tap_schedule[j].tap)) continue;
+        /* a runs for the whole batch before b */
+        int a = group[i] < group[j] ? i : j, b = a == i ? j : i;
+        uint32_t d = (t->off[g_tap_schedule[b].tap] - t->off[g_tap_schedule[a].tap]) & (work_samples - 1);
+        if (d == 0 && b > a) continue;  /* Same tick, original order kept */
+        if (d == 0) d = 1;              /* Same tick, order reversed: no batching */
+        if (d < lookahead) lookahead = d;
+    }
+    return lookahead;
+}
 
-    float wall_scale;
-    if (inst->decay <= mid_norm) {
-        /* 0-50%: linear from 0.5x to 1.0x */
-        float t = inst->decay / mid_norm;
-        wall_scale = min_scale + t * (mid_scale - min_scale);
-    } else {
-        /* 50-100%: linear from 1.0x to maxScale */
-        float t = (inst->decay - mid_norm) / (1.0f - mid_norm);
-        wall_scale = mid_scale + t * (max_scale - mid_scale);
+/* Fills t->lookahead and t->comb_early; needs t->diff_dead */
+static void tap_lookahead(spu_taps_t *t, uint32_t work_samples) {
+    uint8_t group[TAP_COUNT];
+    for (int i = 0; i < TAP_COUNT; i++) group[i] = g_tap_schedule[i].group;
+    /* Comb reads only conflict with writes, never with each other, so each
+     * one's placement is independent */
+    t->comb_early = 0;
+    for (int i = 0; i < TAP_COUNT; i++) {
+        if (g_tap_schedule[i].tap < TAP_COMB || g_tap_schedule[i].tap >= TAP_COMB + 8) continue;
+        uint32_t late = tap_entry_lookahead(t, work_samples, group, i);
+        group[i] = 0;
+        if (tap_entry_lookahead(t, work_samples, group, i) > late) {
+            t->comb_early |= 1u << (g_tap_schedule[i].tap - TAP_COMB);
+        } else {
+            group[i] = g_tap_schedule[i].group;
+        }
     }
+    t->lookahead = work_samples;
+    for (int i = 0; i < TAP_COUNT; i++) {
+        if (t->diff_dead && tap_is_diff(g_tap_schedule[i].tap)) continue;
+        uint32_t d = tap_entry_lookahead(t, work_samples, group, i);
+        if (d < t->lookahead) t->lookahead = d;
+    }
+}
 
-    float target = inst->base.vWALL_f * wall_scale;
-    /* Clamp to stable range */
-    if (target > 0.995f) target = 0.995f;
-    if (target < -0.995f) target = -0.995f;
-    inst->current.vWALL_f = target;
+/* Whether the different-side reflection can be left out without changing
+ * the output. It can when its four addresses are all 0 (Room), so it only
+ * ever writes the cell at base, and every other read lies strictly between
+ * 0 and the furthest other write: that write refills the cell before any
+ * other tap reaches it, leaving the DIFF taps as its only readers. Comb
+ * taps with a zero coefficient are skipped; they only ever add +-0. */
+static uint32_t taps_diff_dead(const scaled_preset_t *p, const spu_taps_t *t) {
+    static const uint8_t diff[] = {TAP_FB + 2, TAP_FB + 3, TAP_REFL + 2, TAP_REFL + 3};
+    static const uint8_t writes[] = {TAP_REFL + 0, TAP_REFL + 1,
+                                     TAP_APF + 0, TAP_APF + 1, TAP_APF + 2, TAP_APF + 3};
+    static const uint8_t reads[] = {
+        TAP_FB + 0, TAP_FB + 1, TAP_HIST + 0, TAP_HIST + 1,
+        TAP_APF_DEL + 0, TAP_APF_DEL + 1, TAP_APF_DEL + 2, TAP_APF_DEL + 3,
+    };
+    const float comb[4] = {p->vCOMB1_f, p->vCOMB2_f, p->vCOMB3_f, p->vCOMB4_f};
+    uint32_t furthest = 0;
+    for (size_t i = 0; i < sizeof(diff); i++) {
+        if (t->off[diff[i]] != 0) return 0;
+    }
+    for (size_t i = 0; i < sizeof(writes); i++) {
+        if (t->off[writes[i]] > furthest) furthest = t->off[writes[i]];
+    }
+    for (size_t i = 0; i < sizeof(reads); i++) {
+        if (t->off[reads[i]] == 0 || t->off[reads[i]] >= furthest) return 0;
+    }
+    for (int n = 0; n < 4; n++) {
+        if (comb[n] == 0.0f) continue;
+        for (int side = 0; side < 2; side++) {
+            uint32_t o = t->off[TAP_COMB + n * 2 + side];
+            if (o == 0 || o >= furthest) return 0;
+        }
+    }
+    return 1;
 }
 
-/* v2 helper: apply preset */
-static void v2_apply_preset(psxverb_instance_t *inst, int idx) {
-    if (idx < 0 || idx >= 6) return;
-    inst->preset_idx = idx;
-    const psx_preset_t *p = &g_presets[idx];
+/* Compile the scaled offsets into the tap program for a work area of
+ * `work_samples` (power of 2) */
+static void build_taps(const scaled_preset_t *p, uint32_t work_samples, spu_taps_t *t) {
+    const int32_t off[TAP_COUNT] = {
+        p->dLSAME, p->dRSAME, p->dRDIFF, p->dLDIFF,
+        p->mLSAME - 1, p->mRSAME - 1, p->mLDIFF - 1, p->mRDIFF - 1,
+        p->mLSAME, p->mRSAME, p->mLDIFF, p->mRDIFF,
+        p->mLCOMB1, p->mRCOMB1, p->mLCOMB2, p->mRCOMB2,
+        p->mLCOMB3, p->mRCOMB3, p->mLCOMB4, p->mRCOMB4,
+        p->mLAPF1 - p->dAPF1, p->mRAPF1 - p->dAPF1, p->mLAPF2 - p->dAPF2, p->mRAPF2 - p->dAPF2,
+        p->mLAPF1, p->mRAPF1, p->mLAPF2, p->mRAPF2,
+    };
+    for (int i = 0; i < TAP_COUNT; i++) {
+        t->off[i] = (uint32_t)off[i] & (work_samples - 1);
+    }
+    t->diff_dead = taps_diff_dead(p, t);
+    tap_lookahead(t, work_samples);
+}
 
-    v2_scale_preset(inst, p, &inst->base);
-    inst->current = inst->base;
+/* Work area size in samples for a preset - matches reference PsxReverb.h Init()
+ * work_size is in bytes at 44.1kHz, convert to samples at the host rate */
+static uint32_t preset_work_samples(const psx_preset_t *p, float rate_scale) {
+    uint32_t work_size = next_pow2((uint32_t)(p->work_size * rate_scale / sizeof(int16_t)));
+    if (work_size > WORK_MAX_SIZE) work_size = WORK_MAX_SIZE;
+    return work_size;
+}
 
-    /* Apply input gain and reverb level */
-    float in_scale = inst->input_gain * 2.0f;
-    inst->current.vLIN_f = inst->base.vLIN_f * in_scale;
-    inst->current.vRIN_f = inst->base.vRIN_f * in_scale;
-    float out_scale = inst->reverb_level * 4.0f;
-    inst->current.vLOUT_f = inst->base.vLOUT_f * out_scale;
-    inst->current.vROUT_f = inst->base.vROUT_f * out_scale;
+/* Shared table for a sample rate, built on first use (create_instance only,
+ * never on the audio path) over the whole preset list. Returns NULL if the
+ * cache is full or out of memory. */
+static const rate_table_t *rate_table_get(int sample_rate) {
+    const rate_table_t *found = NULL;
 
-    v2_update_decay(inst);
+    while (atomic_flag_test_and_set_explicit(&g_rate_table_lock, memory_order_acquire)) {}
 
-    /* Initialize work area - matches reference PsxReverb.h Init()
-     * work_size is in bytes at 44.1kHz, convert to samples at 48kHz */
-    uint32_t work_size = next_pow2((uint32_t)(p->work_size * RATE_SCALE / sizeof(int16_t)));
-    if (work_size > WORK_MAX_SIZE) work_size = WORK_MAX_SIZE;
+    for (int i = 0; i < g_rate_table_count; i++) {
+        if (g_rate_tables[i].sample_rate == sample_rate) found = &g_rate_tables[i];
+    }
+    if (!found && g_rate_table_count < RATE_TABLE_SLOTS) {
+        rate_table_t *t = &g_rate_tables[g_rate_table_count];
+        float rate_scale = (float)sample_rate / (float)PSX_NATIVE_RATE;
+        t->presets = (scaled_preset_t*)calloc((size_t)g_preset_count, sizeof(scaled_preset_t));
+        t->work_samples = (uint32_t*)calloc((size_t)g_preset_count, sizeof(uint32_t));
+        if (t->presets && t->work_samples) {
+            t->sample_rate = sample_rate;
+            for (int i = 0; i < g_preset_count; i++) {
+                scale_preset(&g_preset_list[i], rate_scale, &t->presets[i]);
+                t->work_samples[i] = preset_work_samples(&g_preset_list[i], rate_scale);
+                build_taps(&t->presets[i], t->work_samples[i], &t->presets[i].taps);
+            }
+            g_rate_table_count++;
+            found = t;
+        } else {
+            free(t->presets);
+            free(t->work_samples);
+            t->presets = NULL;
+            t->work_samples = NULL;
+        }
+    }
 
-    memset(inst->work_buffer, 0, work_size * sizeof(int16_t));
-    inst->work.buf = inst->work_buffer;
-    inst->work.size_mask = work_size - 1;
-    inst->work.base = 0;
+    atomic_flag_clear_explicit(&g_rate_table_lock, memory_order_release);
+    return found;
 }
 
-/* v2 API: create instance */
-static void* v2_create_instance(const char *module_dir, const char *config_json) {
-    psxverb_instance_t *inst = (psxverb_instance_t*)calloc(1, sizeof(psxverb_instance_t));
-    if (!inst) return NULL;
-
-    inst->work_buffer = (int16_t*)calloc(WORK_MAX_SIZE, sizeof(int16_t));
-    if (!inst->work_buffer) {
-        free(inst);
-        return NULL;
-    }
+/* ============================================================================
+ * PARAMETER MAILBOX
+ * set_param/get_param run on the UI thread, process_block on the audio
+ * thread. The UI side owns a full parameter set and publishes a copy through
+ * a triple buffer: one atomic exchange per publish, one per consume, never
+ * blocking either side and always delivering the latest values.
+ * ============================================================================ */
 
-    /* Initialize state */
-    inst->preset_idx = 4;       /* Default: Hall */
-    inst->decay = 0.7f;         /* With formula 0.5+(d*0.5), 0.7 gives 0.85x wall feedback */
-    inst->mix = 0.35f;
-    inst->input_gain = 0.5f;
-    inst->reverb_level = 0.5f;
+/* User-facing parameters as one snapshot */
+typedef struct {
+    int preset;
+    float decay;
+    float mix;
+    float input_gain;
+    float reverb_level;
+    float crossfade_ms;     /* Preset change crossfade length */
+    int engine;             /* ENGINE_FLOAT or ENGINE_FIXED */
+    int routing;            /* ROUTING_INSERT, ROUTING_WET or ROUTING_MONO */
+    int resampler;          /* RESAMPLER_HB39, _HB11, _LINEAR or _IIR */
+    int freeze;             /* FREEZE_OFF, FREEZE_LOOP or FREEZE_REVERSE */
+    uint32_t restores;      /* Bumped by each state restore: jump, don't ramp */
+} psxverb_params_t;
 
-    /* Initialize halfband filters */
-    halfband_init(&inst->down_l);
-    halfband_init(&inst->down_r);
-    halfband_init(&inst->up_l);
-    halfband_init(&inst->up_r);
+#define MAILBOX_FRESH 4u    /* Set in `middle` when it holds an unread publish */
 
-    /* Apply default preset */
-    v2_apply_preset(inst, inst->preset_idx);
+typedef struct {
+    psxverb_params_t slot[3];
+    _Atomic uint32_t middle;  /* Handoff slot index | MAILBOX_FRESH */
+    uint32_t back;            /* UI thread's slot */
+    uint32_t front;           /* Audio thread's slot */
+} params_mailbox_t;
 
-    fx_log("PSX Verb v2 instance created");
-    return inst;
+static void mailbox_init(params_mailbox_t *m, const psxverb_params_t *p) {
+    m->slot[0] = m->slot[1] = m->slot[2] = *p;
+    m->front = 0;
+    atomic_init(&m->middle, 1);
+    m->back = 2;
 }
 
-/* v2 API: destroy instance */
-static void v2_destroy_instance(void *instance) {
-    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
-    if (!inst) return;
+/* UI thread: publish a new snapshot */
+static void mailbox_publish(params_mailbox_t *m, const psxverb_params_t *p) {
+    m->slot[m->back] = *p;
+    uint32_t prev = atomic_exchange_explicit(&m->middle, m->back | MAILBOX_FRESH,
+                                             memory_order_acq_rel);
+    m->back = prev & ~MAILBOX_FRESH;
+}
 
-    if (inst->work_buffer) {
-        free(inst->work_buffer);
-    }
-    free(inst);
-    fx_log("PSX Verb v2 instance destroyed");
+/* Audio thread: latest snapshot if one was published since the last call */
+static const psxverb_params_t *mailbox_consume(params_mailbox_t *m) {
+    if (!(atomic_load_explicit(&m->middle, memory_order_relaxed) & MAILBOX_FRESH)) return NULL;
+    uint32_t prev = atomic_exchange_explicit(&m->middle, m->front, memory_order_acq_rel);
+    m->front = prev & ~MAILBOX_FRESH;
+    return &m->slot[m->front];
 }
 
-/* v2 API: process block */
-static void v2_process_block(void *instance, int16_t *audio_inout, int frames) {
-    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
-    if (!inst) return;
+/* Work area memory handed between threads as a single pointer: the
+ * capacity travels in the header so ownership moves with one atomic op. */
+typedef struct {
+    uint32_t capacity;                  /* Samples in data (positions, multi-bus) */
+    uint32_t bytes;                     /* Whole allocation, header included */
+    uint32_t arena_page;                /* First huge page arena page + 1, 0 = heap */
+    uint8_t locked;                     /* Resident and mlock()ed */
+    int32_t state_preset;               /* Saved work area (see STATE): its preset, -1 = none */
+    uint32_t state_base;                /* and its base position */
+    _Alignas(WORK_ALIGN) int16_t data[];
+} work_buf_t;
 
-    const scaled_preset_t *p = &inst->current;
+#if PSXVERB_PROFILE
+/* ============================================================================
+ * PROFILING (PSXVERB_PROFILE builds only)
+ * process_block records its duration into a rolling window; perf_stats
+ * summarises it on the UI thread. Every field is written by the audio
+ * thread only, with relaxed atomics so the UI can read without locking.
+ * perf_reset is a request flag honoured at the next block.
+ * ============================================================================ */
 
-    for (int i = 0; i < frames; i += 2) {
-        if (i + 1 >= frames) break;
+#define PERF_WINDOW 512     /* Calls in the rolling window (~1.5 s at 128 frames) */
 
-        float in_l0 = audio_inout[i * 2] / 32768.0f;
-        float in_r0 = audio_inout[i * 2 + 1] / 32768.0f;
-        float in_l1 = audio_inout[(i + 1) * 2] / 32768.0f;
-        float in_r1 = audio_inout[(i + 1) * 2 + 1] / 32768.0f;
+typedef struct {
+    _Atomic uint32_t window[PERF_WINDOW];  /* Timer ticks per call */
+    _Atomic uint32_t calls;                /* Calls since reset; window index = calls % PERF_WINDOW */
+    _Atomic uint32_t saturations;
+    _Atomic uint32_t clips;
+    _Atomic uint32_t reset;                /* UI -> audio: clear before the next call */
+} perf_stats_t;
 
-        float Lin = halfband_decimate(&inst->down_l, in_l0, in_l1) * p->vLIN_f;
-        float Rin = halfband_decimate(&inst->down_r, in_r0, in_r1) * p->vRIN_f;
+static uint64_t g_perf_freq;   /* Timer ticks per second */
 
-        /* Same-side reflection */
-        float lsame_fb = workarea_read_relative(&inst->work, p->dLSAME);
-        float lsame_iir = workarea_read_relative(&inst->work, p->mLSAME - 1);
-        float lsame_out = (Lin + lsame_fb * p->vWALL_f - lsame_iir) * p->vIIR_f + lsame_iir;
-        workarea_write_relative(&inst->work, p->mLSAME, lsame_out);
-
-        float rsame_fb = workarea_read_relative(&inst->work, p->dRSAME);
-        float rsame_iir = workarea_read_relative(&inst->work, p->mRSAME - 1);
-        float rsame_out = (Rin + rsame_fb * p->vWALL_f - rsame_iir) * p->vIIR_f + rsame_iir;
-        workarea_write_relative(&inst->work, p->mRSAME, rsame_out);
-
-        /* Different-side reflection */
-        float ldiff_fb = workarea_read_relative(&inst->work, p->dRDIFF);
-        float ldiff_iir = workarea_read_relative(&inst->work, p->mLDIFF - 1);
-        float ldiff_out = (Lin + ldiff_fb * p->vWALL_f - ldiff_iir) * p->vIIR_f + ldiff_iir;
-        workarea_write_relative(&inst->work, p->mLDIFF, ldiff_out);
-
-        float rdiff_fb = workarea_read_relative(&inst->work, p->dLDIFF);
-        float rdiff_iir = workarea_read_relative(&inst->work, p->mRDIFF - 1);
-        float rdiff_out = (Rin + rdiff_fb * p->vWALL_f - rdiff_iir) * p->vIIR_f + rdiff_iir;
-        workarea_write_relative(&inst->work, p->mRDIFF, rdiff_out);
+/* ARMv8 virtual counter where available: one register read, no syscall */
+static inline uint64_t perf_now(void) {
+#if defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
 
-        /* Comb filter bank */
-        float Lout = p->vCOMB1_f * workarea_read_relative(&inst->work, p->mLCOMB1) +
-                     p->vCOMB2_f * workarea_read_relative(&inst->work, p->mLCOMB2) +
-                     p->vCOMB3_f * workarea_read_relative(&inst->work, p->mLCOMB3) +
-                     p->vCOMB4_f * workarea_read_relative(&inst->work, p->mLCOMB4);
+static void perf_init_timer(void) {
+#if defined(__aarch64__)
+    uint64_t f;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(f));
+    g_perf_freq = f ? f : 1;
+#else
+    g_perf_freq = 1000000000ull;
+#endif
+}
+#endif
 
-        float Rout = p->vCOMB1_f * workarea_read_relative(&inst->work, p->mRCOMB1) +
-                     p->vCOMB2_f * workarea_read_relative(&inst->work, p->mRCOMB2) +
-                     p->vCOMB3_f * workarea_read_relative(&inst->work, p->mRCOMB3) +
-                     p->vCOMB4_f * workarea_read_relative(&inst->work, p->mRCOMB4);
+/* ============================================================================
+ * AUDIO FX API v2 - Instance-based
+ * ============================================================================ */
 
-        /* All-pass filter 1 */
-        float lapf1_del = workarea_read_relative(&inst->work, p->mLAPF1 - p->dAPF1);
-        Lout -= p->vAPF1_f * lapf1_del;
-        workarea_write_relative(&inst->work, p->mLAPF1, Lout);
-        Lout = Lout * p->vAPF1_f + lapf1_del;
+/* One SPU reverb core's memory: a work area plus how much of it is known
+ * to be zero. Two cores let a preset change crossfade the old tail out while
+ * the new preset starts from a cleared work area. */
+typedef struct {
+    work_buf_t *mem;       /* Cache-aligned SPU RAM */
+    uint32_t clean;        /* Samples of mem zeroed so far, from the start (guard included) */
+    workarea_t work;
+} spu_core_t;
 
-        float rapf1_del = workarea_read_relative(&inst->work, p->mRAPF1 - p->dAPF1);
-        Rout -= p->vAPF1_f * rapf1_del;
-        workarea_write_relative(&inst->work, p->mRAPF1, Rout);
-        Rout = Rout * p->vAPF1_f + rapf1_del;
+/* The SPU volumes that follow user parameters (decay, input_gain,
+ * reverb_level). process_block latches targets from the parameter snapshot
+ * and ramps the live values in inst->current towards them. */
+typedef struct {
+    float vWALL, vLIN, vRIN, vLOUT, vROUT;
+} spu_volumes_t;
 
-        /* All-pass filter 2 */
-        float lapf2_del = workarea_read_relative(&inst->work, p->mLAPF2 - p->dAPF2);
-        Lout -= p->vAPF2_f * lapf2_del;
-        workarea_write_relative(&inst->work, p->mLAPF2, Lout);
-        Lout = Lout * p->vAPF2_f + lapf2_del;
+#define STATE_JSON_MAX 256
 
-        float rapf2_del = workarea_read_relative(&inst->work, p->mRAPF2 - p->dAPF2);
-        Rout -= p->vAPF2_f * rapf2_del;
-        workarea_write_relative(&inst->work, p->mRAPF2, Rout);
-        Rout = Rout * p->vAPF2_f + rapf2_del;
+/* Work area copies kept by set_param("snapshot", "take"), see TAIL FREEZE */
+#ifndef PSXVERB_SNAPSHOT_SLOTS
+#define PSXVERB_SNAPSHOT_SLOTS 4
+#endif
 
-        workarea_advance(&inst->work, 1);
+/* Meter values published once per window, see METERING */
+enum {
+    METER_IN_PEAK,          /* Linear, input */
+    METER_IN_MS,            /* Mean square, input */
+    METER_OUT_PEAK,
+    METER_OUT_MS,
+    METER_WORK_MS,          /* Mean square of the work area, last full sweep */
+    METER_OCCUPANCY,        /* Fraction of work area samples above the noise floor */
+    METER_WALL,             /* Active vWALL_f, vIIR_f and same-side loop */
+    METER_IIR,              /* length in SPU ticks, for the model RT60 */
+    METER_LOOP_TICKS,
+    METER_RT60_MEASURED,    /* Seconds, from the output decay in silence; 0 = none yet */
+    METER_COUNT
+};
 
-        float out_l0, out_l1, out_r0, out_r1;
-        halfband_interpolate(&inst->up_l, Lout * p->vLOUT_f, &out_l0, &out_l1);
-        halfband_interpolate(&inst->up_r, Rout * p->vROUT_f, &out_r0, &out_r1);
+/* Audio side accumulators */
+typedef struct {
+    float in_peak, out_peak;
+    float in_energy, out_energy;    /* Sums of squares */
+    uint32_t samples;               /* Samples in the energies */
+    uint32_t frames;                /* Frames in this window */
+    uint32_t sweep_pos;             /* Next work area sample to scan */
+    uint32_t sweep_count, sweep_active;
+    float sweep_energy;
+    float work_ms, occupancy;       /* Last full sweep */
+    float prev_out_ms;              /* Last window's, for the measured decay */
+    float rt60;
+} meter_acc_t;
 
-        float dry_mix = 1.0f - inst->mix;
-        float wet_mix = inst->mix;
+/* Seqlock: seq is odd while the audio thread writes v */
+typedef struct {
+    _Atomic uint32_t seq;
+    _Atomic float v[METER_COUNT];
+} meter_pub_t;
 
-        float final_l0 = clamp_f(in_l0 * dry_mix + out_l0 * wet_mix, -1.0f, 1.0f);
-        float final_r0 = clamp_f(in_r0 * dry_mix + out_r0 * wet_mix, -1.0f, 1.0f);
-        float final_l1 = clamp_f(in_l1 * dry_mix + out_l1 * wet_mix, -1.0f, 1.0f);
-        float final_r1 = clamp_f(in_r1 * dry_mix + out_r1 * wet_mix, -1.0f, 1.0f);
+/* SPU core kernels, see ENGINE DISPATCH */
+typedef void (*spu_kernel_fn)(workarea_t *wa, scaled_preset_t *p,
+                              const float *in_l, const float *in_r,
+                              float *out_l, float *out_r, int ticks);
+typedef void (*spu_ramp_kernel_fn)(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                                   const float *in_l, const float *in_r,
+                                   float *out_l, float *out_r, int ticks);
 
-        audio_inout[i * 2] = (int16_t)(final_l0 * 32767.0f);
-        audio_inout[i * 2 + 1] = (int16_t)(final_r0 * 32767.0f);
-        audio_inout[(i + 1) * 2] = (int16_t)(final_l1 * 32767.0f);
-        audio_inout[(i + 1) * 2 + 1] = (int16_t)(final_r1 * 32767.0f);
-    }
-}
+/* Multi-bus instances (see MULTI-BUS): create_instance config {"buses": K} */
+#ifndef PSXVERB_MAX_BUSES
+#define PSXVERB_MAX_BUSES 8
+#endif
+#define SPU_BUS_LANES 4         /* Buses per SIMD op */
 
-/* v2 API: set parameter */
-static void v2_set_param(void *instance, const char *key, const char *val) {
-    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
-    if (!inst || !key || !val) return;
+/* Resampler state of one extra bus */
+typedef struct {
+    hb_decimator_t down;
+    hb_mono_decimator_t down_mono;
+    hb_interpolator_t up;
+} bus_filters_t;
 
-    /* State restore from patch save */
-    if (strcmp(key, "state") == 0) {
-        float v;
-        int preset_changed = 0;
-        if (json_get_number(val, "preset", &v) == 0) {
-            int idx = (int)v;
-            if (idx >= 0 && idx < 6 && idx != inst->preset_idx) {
-                inst->preset_idx = idx;
-                preset_changed = 1;
-            }
-        }
-        if (json_get_number(val, "decay", &v) == 0) { inst->decay = clamp_f(v, 0.0f, 1.0f); }
-        if (json_get_number(val, "mix", &v) == 0) { inst->mix = clamp_f(v, 0.0f, 1.0f); }
-        if (json_get_number(val, "input_gain", &v) == 0) { inst->input_gain = clamp_f(v, 0.0f, 1.0f); }
-        if (json_get_number(val, "reverb_level", &v) == 0) { inst->reverb_level = clamp_f(v, 0.0f, 1.0f); }
+typedef struct {
+    /* UI thread (set_param/get_param) */
+    psxverb_params_t ui;        /* Authoritative user parameters */
+    uint32_t ui_work_max;       /* Largest work area requested so far */
+    uint32_t ui_unlocked;       /* Owned work buffers that mlock() refused */
+    char state_json[STATE_JSON_MAX];  /* Cached get_param("state") */
+    int state_json_len;         /* 0 = stale */
+    uint32_t ui_ring_slot;      /* Slot size of the last snapshot ring handed over */
 
-        /* Apply preset (which also updates decay and gain settings) */
-        if (preset_changed) {
-            v2_apply_preset(inst, inst->preset_idx);
-        } else {
-            /* Update derived values without changing preset */
-            v2_update_decay(inst);
-            float in_scale = inst->input_gain * 2.0f;
-            inst->current.vLIN_f = inst->base.vLIN_f * in_scale;
-            inst->current.vRIN_f = inst->base.vRIN_f * in_scale;
-            float out_scale = inst->reverb_level * 4.0f;
-            inst->current.vLOUT_f = inst->base.vLOUT_f * out_scale;
-            inst->current.vROUT_f = inst->base.vROUT_f * out_scale;
-        }
-        return;
-    }
+    /* Cross-thread handoff */
+    params_mailbox_t mailbox;
+    _Atomic(work_buf_t *) spare_next;   /* UI -> audio: larger spare work area */
+    _Atomic(work_buf_t *) retired;      /* Audio -> UI: buffer to free */
+    _Atomic uint32_t min_capacity;      /* Smaller of the two cores' capacities */
+    _Atomic uint32_t carry_latency;     /* Audio -> UI: frames added by carry mode */
+    _Atomic uint32_t denormal_chunks;   /* Audio -> UI: chunks run on the DC floor */
+    _Atomic(work_buf_t *) restore_next; /* UI -> audio: saved work area to resume from */
+    _Atomic(work_buf_t *) capture_req;  /* UI -> audio: buffer to copy the work area into */
+    _Atomic(work_buf_t *) capture_done; /* Audio -> UI: capture_req, filled */
+    _Atomic(work_buf_t *) ring_next;    /* UI -> audio: larger snapshot ring */
+    _Atomic(work_buf_t *) ring_retired; /* Audio -> UI: replaced ring to free */
+    _Atomic uint32_t snap_take;         /* UI -> audio: snapshot requests so far */
+    _Atomic uint32_t snap_recall;       /* UI -> audio: age + 1 to recall, 0 = none */
+    _Atomic uint32_t snap_taken;        /* Audio -> UI: snapshots in the ring */
+    meter_pub_t meters;                 /* Audio -> UI: levels, see METERING */
 
-    if (strcmp(key, "preset") == 0 || strcmp(key, "model") == 0) {
-        int idx = -1;
-        /* Accept both string names and numeric indices */
-        if (strcmp(val, "Room") == 0) idx = 0;
-        else if (strcmp(val, "Studio S") == 0) idx = 1;
-        else if (strcmp(val, "Studio M") == 0) idx = 2;
-        else if (strcmp(val, "Studio L") == 0) idx = 3;
-        else if (strcmp(val, "Hall") == 0) idx = 4;
-        else if (strcmp(val, "Space Echo") == 0) idx = 5;
-        else idx = atoi(val);
-        if (idx >= 0 && idx < 6 && idx != inst->preset_idx) {
-            v2_apply_preset(inst, idx);
-        }
-    } else if (strcmp(key, "decay") == 0) {
-        inst->decay = clamp_f(atof(val), 0.0f, 1.0f);
-        v2_update_decay(inst);
-    } else if (strcmp(key, "mix") == 0) {
-        inst->mix = clamp_f(atof(val), 0.0f, 1.0f);
-    } else if (strcmp(key, "input_gain") == 0) {
-        inst->input_gain = clamp_f(atof(val), 0.0f, 1.0f);
-        float in_scale = inst->input_gain * 2.0f;
-        inst->current.vLIN_f = inst->base.vLIN_f * in_scale;
-        inst->current.vRIN_f = inst->base.vRIN_f * in_scale;
+    /* Shared, read-only */
+    const rate_table_t *rates;  /* Presets scaled to the host sample rate */
+    int sample_rate;
+    int buses;                  /* Stereo buses, 1 unless multi-bus */
+    uint32_t lanes;             /* Work area samples per position: 1, or buses rounded up to SPU_BUS_LANES */
+    bus_filters_t *bus;         /* Buses 1 to buses - 1; bus 0 uses down/down_mono/up */
+
+    /* Audio thread (process_block) */
+    psxverb_params_t live;      /* Last snapshot taken from the mailbox */
+    spu_core_t core[2];
+    int active;                 /* Core running the current preset */
+    int active_preset;          /* Preset the active core is running */
+    int pending_preset;         /* Applied once the spare core is ready, or -1 */
+    scaled_preset_t current;
+    const scaled_preset_t *base;  /* Unmodified preset in the shared rate table */
+    scaled_preset_t fade_preset;  /* Outgoing preset during a crossfade */
+    int fade_index;             /* Preset fade_preset was loaded from */
+    spu_kernel_fn kernel;       /* Static kernel for the active preset */
+    spu_kernel_fn fade_kernel;  /* Static kernel for fade_preset */
+    spu_ramp_kernel_fn ramp_kernel;  /* Ramped kernel for the active preset */
+    float wall_max_scale;       /* Max safe decay scale for the active preset */
+    spu_volumes_t target;       /* Latched from the parameter snapshot */
+    spu_volumes_t ramp_step;    /* Per-tick increment while ramping */
+    float mix_cur;              /* Live mix, ramps towards live.mix */
+    float mix_step;             /* Per-frame increment while ramping */
+    uint32_t ramp_remaining;    /* Ticks left in the parameter ramp, 0 = static */
+    int params_dirty;           /* Targets changed since the last block */
+    int started;                /* A block has run; until then changes apply at once */
+    uint32_t fade_ticks;        /* Crossfade length in ticks */
+    uint32_t fade_remaining;    /* Ticks left in the crossfade, 0 = none */
+    uint32_t quiet_ticks;       /* Consecutive ticks of silent input and tail */
+    uint32_t quiet_scan;        /* Work area samples found empty in this pass */
+    int sleeping;               /* Bypassed until the input is non-zero */
+    work_buf_t *ring;           /* Snapshot ring: PSXVERB_SNAPSHOT_SLOTS equal slots */
+    uint32_t snap_seen;         /* snap_take value last served */
+    int32_t snap_preset[PSXVERB_SNAPSHOT_SLOTS];  /* Preset per slot, -1 = empty */
+    uint32_t snap_base[PSXVERB_SNAPSHOT_SLOTS];   /* Work area base per slot */
+    int carry_mode;             /* An odd block was seen; output runs one frame late */
+    int carry_held;             /* carry_in holds an unpaired input frame */
+    float carry_in[PSXVERB_MAX_BUSES][2];   /* Input frame waiting for its pair, in io units */
+    float carry_out[PSXVERB_MAX_BUSES][2];  /* Processed frame due at the start of the next call */
+    hb_decimator_t down;
+    hb_mono_decimator_t down_mono;  /* Summed input, ROUTING_MONO only */
+    hb_interpolator_t up;
+    meter_acc_t meter;
+
+#if PSXVERB_PROFILE
+    perf_stats_t perf;
+#endif
+} psxverb_instance_t;
+
+/* v2 helper: update decay - adaptive formula from shared_dsp/PsxReverb.h
+ * Automatically calculates safe maximum scale per preset to prevent oscillation.
+ * - 0-50% decay maps to [0.5x, 1.0x] (below authentic to authentic PSX)
+ * - 50-100% decay maps to [1.0x, maxScale] (authentic to maximum safe)
+ * - Final value clamped to [-0.995, 0.995] to prevent runaway feedback
+ */
+static void v2_update_decay(psxverb_instance_t *inst) {
+    float max_scale = inst->wall_max_scale;
+    float min_scale = 0.5f;
+    float mid_scale = 1.0f;  /* authentic PSX at 50% */
+    float mid_norm = 0.5f;
+
+    float wall_scale;
+    float decay = inst->live.decay;
+    if (decay <= mid_norm) {
+        /* 0-50%: linear from 0.5x to 1.0x */
+        float t = decay / mid_norm;
+        wall_scale = min_scale + t * (mid_scale - min_scale);
+    } else {
+        /* 50-100%: linear from 1.0x to maxScale */
+        float t = (decay - mid_norm) / (1.0f - mid_norm);
+        wall_scale = mid_scale + t * (max_scale - mid_scale);
+    }
+
+    float target = inst->base->vWALL_f * wall_scale;
+    /* Clamp to stable range */
+    if (target > 0.995f) target = 0.995f;
+    if (target < -0.995f) target = -0.995f;
+    inst->target.vWALL = target;
+    inst->params_dirty = 1;
+}
+
+/* v2 helper: maximum safe decay scale for the loaded preset, computed once
+ * per preset instead of on every decay change */
+static void v2_update_wall_limit(psxverb_instance_t *inst) {
+    float base = inst->base->vWALL_f;
+    if (base < 0) base = -base;  /* abs() */
+    if (base < 1e-5f) base = 1e-5f;  /* avoid div by zero */
+
+    float max_scale = 0.99f / base;
+    if (max_scale < 0.5f) max_scale = 0.5f;
+    if (max_scale > 10.0f) max_scale = 10.0f;
+    inst->wall_max_scale = max_scale;
+}
+
+/* v2 helper: derive input/output volume targets from input_gain and reverb_level */
+static void v2_update_gains(psxverb_instance_t *inst) {
+    float in_scale = inst->live.input_gain * 2.0f;
+    inst->target.vLIN = inst->base->vLIN_f * in_scale;
+    inst->target.vRIN = inst->base->vRIN_f * in_scale;
+    float out_scale = inst->live.reverb_level * 4.0f;
+    inst->target.vLOUT = inst->base->vLOUT_f * out_scale;
+    inst->target.vROUT = inst->base->vROUT_f * out_scale;
+    inst->params_dirty = 1;
+}
+
+/* Jump the live volumes to their targets (no ramp) */
+static void v2_snap_volumes(psxverb_instance_t *inst) {
+    inst->current.vWALL_f = inst->target.vWALL;
+    inst->current.vLIN_f = inst->target.vLIN;
+    inst->current.vRIN_f = inst->target.vRIN;
+    inst->current.vLOUT_f = inst->target.vLOUT;
+    inst->current.vROUT_f = inst->target.vROUT;
+}
+
+/* v2 helper: load preset coefficients into base/current (no memory work) */
+static void v2_load_preset(psxverb_instance_t *inst, int idx) {
+    inst->active_preset = idx;
+    inst->base = &inst->rates->presets[idx];
+    inst->current = *inst->base;
+    v2_update_wall_limit(inst);
+    v2_update_gains(inst);
+    v2_update_decay(inst);
+
+    /* A new preset starts at its targets; the crossfade covers the change */
+    v2_snap_volumes(inst);
+    inst->ramp_remaining = 0;
+}
+
+/* ============================================================================
+ * WORK AREA MEMORY
+ * Work buffers are only allocated on the UI thread, zeroed there (which
+ * faults every page in) and mlock()ed, so process_block never page faults
+ * on them or has them reclaimed. Heap buffers are page aligned and padded to
+ * whole pages so munlock() on free cannot unlock a neighbour's page.
+ *
+ * Build with -DPSXVERB_HUGE_ARENA_MB=N to carve buffers out of one N MB
+ * arena shared by all instances instead: MAP_HUGETLB if the kernel has huge
+ * pages reserved, else transparent huge pages. It is mapped, pre-faulted and
+ * locked once; buffers that do not fit fall back to the heap. mlock failures
+ * (RLIMIT_MEMLOCK) are not fatal and show in get_param("memory").
+ * ============================================================================ */
+
+#ifndef PSXVERB_HUGE_ARENA_MB
+#define PSXVERB_HUGE_ARENA_MB 0
+#endif
+
+#define WORK_PAGE 4096              /* Huge page arena allocation unit */
+#define HUGE_PAGE (2u << 20)
+
+enum { MEM_HEAP, MEM_HUGETLB, MEM_THP };
+static const char *const g_mem_backing_names[] = {"heap", "hugetlb", "thp"};
+
+static _Atomic uint32_t g_mem_locked_kb;        /* Work memory currently locked */
+static _Atomic uint32_t g_mem_lock_failures;    /* mlock() refusals since load */
+
+static size_t mem_page_size(void) {
+    static size_t page;
+    if (!page) {
+        long p = sysconf(_SC_PAGESIZE);
+        page = p > 0 ? (size_t)p : WORK_PAGE;
+    }
+    return page;
+}
+
+#if PSXVERB_HUGE_ARENA_MB > 0
+#define ARENA_BYTES ((size_t)PSXVERB_HUGE_ARENA_MB << 20)
+#define ARENA_PAGES (ARENA_BYTES / WORK_PAGE)
+
+static uint8_t *g_arena;                /* NULL until mapped */
+static int g_arena_state;               /* 0 untried, 1 mapped, -1 failed */
+static int g_arena_backing = MEM_HEAP;
+static uint8_t g_arena_locked;
+static uint8_t g_arena_used[ARENA_PAGES];
+static atomic_flag g_arena_lock = ATOMIC_FLAG_INIT;
+
+/* Map, pre-fault and lock the arena. Caller holds g_arena_lock. */
+static void arena_map(void) {
+    void *p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, ARENA_BYTES, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) g_arena_backing = MEM_HUGETLB;
+#endif
+    if (p == MAP_FAILED) {
+        /* Over-map so the arena can start on a huge page boundary */
+        size_t span = ARENA_BYTES + HUGE_PAGE;
+        uint8_t *raw = mmap(NULL, span, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            g_arena_state = -1;
+            fx_log("huge page arena unavailable, using heap work buffers");
+            return;
+        }
+        uint8_t *start = (uint8_t*)(((uintptr_t)raw + HUGE_PAGE - 1) & ~(uintptr_t)(HUGE_PAGE - 1));
+        if (start > raw) munmap(raw, (size_t)(start - raw));
+        if (start + ARENA_BYTES < raw + span) {
+            munmap(start + ARENA_BYTES, (size_t)(raw + span - start - ARENA_BYTES));
+        }
+        p = start;
+#ifdef MADV_HUGEPAGE
+        madvise(p, ARENA_BYTES, MADV_HUGEPAGE);
+#endif
+        g_arena_backing = MEM_THP;
+    }
+    memset(p, 0, ARENA_BYTES);
+    g_arena_locked = mlock(p, ARENA_BYTES) == 0;
+    if (g_arena_locked) {
+        atomic_fetch_add(&g_mem_locked_kb, (uint32_t)(ARENA_BYTES >> 10));
+    } else {
+        atomic_fetch_add(&g_mem_lock_failures, 1);
+    }
+    g_arena = p;
+    g_arena_state = 1;
+}
+
+/* First-fit run of pages for `bytes`, zeroed, or NULL */
+static work_buf_t *arena_alloc(size_t bytes) {
+    uint32_t pages = (uint32_t)((bytes + WORK_PAGE - 1) / WORK_PAGE);
+    work_buf_t *w = NULL;
+
+    while (atomic_flag_test_and_set_explicit(&g_arena_lock, memory_order_acquire)) {}
+    if (g_arena_state == 0) arena_map();
+    if (g_arena_state > 0) {
+        uint32_t run = 0;
+        for (uint32_t i = 0; i < ARENA_PAGES; i++) {
+            run = g_arena_used[i] ? 0 : run + 1;
+            if (run == pages) {
+                uint32_t first = i + 1 - pages;
+                memset(g_arena_used + first, 1, pages);
+                w = (work_buf_t*)(g_arena + (size_t)first * WORK_PAGE);
+                memset(w, 0, (size_t)pages * WORK_PAGE);
+                w->bytes = pages * WORK_PAGE;
+                w->arena_page = first + 1;
+                w->locked = g_arena_locked;
+                break;
+            }
+        }
+    }
+    atomic_flag_clear_explicit(&g_arena_lock, memory_order_release);
+    return w;
+}
+
+static void arena_free(work_buf_t *w) {
+    uint32_t first = w->arena_page - 1;
+    uint32_t pages = w->bytes / WORK_PAGE;
+    while (atomic_flag_test_and_set_explicit(&g_arena_lock, memory_order_acquire)) {}
+    memset(g_arena_used + first, 0, pages);
+    atomic_flag_clear_explicit(&g_arena_lock, memory_order_release);
+}
+#endif
+
+/* Backing of new work buffers, for get_param("memory") */
+static int mem_backing(void) {
+#if PSXVERB_HUGE_ARENA_MB > 0
+    return g_arena_state > 0 ? g_arena_backing : MEM_HEAP;
+#else
+    return MEM_HEAP;
+#endif
+}
+
+/* Allocate a zeroed, resident, cache-aligned work buffer (never on the
+ * audio path) of `samples` positions, `lanes` samples each */
+static work_buf_t *work_alloc(uint32_t samples, uint32_t lanes) {
+    size_t bytes = sizeof(work_buf_t) + (size_t)(samples + WORK_GUARD) * lanes * sizeof(int16_t);
+    work_buf_t *w = NULL;
+#if PSXVERB_HUGE_ARENA_MB > 0
+    w = arena_alloc(bytes);
+#endif
+    if (!w) {
+        size_t page = mem_page_size();
+        bytes = (bytes + page - 1) & ~(page - 1);
+        w = (work_buf_t*)aligned_alloc(page, bytes);
+        if (!w) return NULL;
+        memset(w, 0, bytes);
+        w->bytes = (uint32_t)bytes;
+        w->locked = mlock(w, bytes) == 0;
+        if (w->locked) {
+            atomic_fetch_add(&g_mem_locked_kb, (uint32_t)(bytes >> 10));
+        } else {
+            atomic_fetch_add(&g_mem_lock_failures, 1);
+        }
+    }
+    w->capacity = samples;
+    return w;
+}
+
+static void work_release(work_buf_t *w) {
+    if (!w) return;
+#if PSXVERB_HUGE_ARENA_MB > 0
+    if (w->arena_page) {
+        arena_free(w);
+        return;
+    }
+#endif
+    if (w->locked) {
+        munlock(w, w->bytes);
+        atomic_fetch_sub(&g_mem_locked_kb, w->bytes >> 10);
+    }
+    free(w);
+}
+
+/* Instance-side wrappers that keep ui_unlocked in step (UI thread) */
+static work_buf_t *v2_work_alloc(psxverb_instance_t *inst, uint32_t samples) {
+    work_buf_t *w = work_alloc(samples, inst->lanes);
+    if (w && !w->locked) inst->ui_unlocked++;
+    return w;
+}
+
+static void v2_work_release(psxverb_instance_t *inst, work_buf_t *w) {
+    if (w && !w->locked) inst->ui_unlocked--;
+    work_release(w);
+}
+
+/* memory JSON: whether every work buffer this instance owns is locked */
+static int v2_get_memory(psxverb_instance_t *inst, char *buf, int buf_len) {
+    return snprintf(buf, buf_len,
+        "{\"locked\":%s,\"backing\":\"%s\",\"locked_kb\":%u,\"lock_failures\":%u}",
+        inst->ui_unlocked ? "false" : "true", g_mem_backing_names[mem_backing()],
+        atomic_load(&g_mem_locked_kb), atomic_load(&g_mem_lock_failures));
+}
+
+/* ============================================================================
+ * TAIL FREEZE AND SNAPSHOTS
+ * freeze stops feeding the work area: while frozen the SPU kernels are
+ * swapped for read-only replay kernels (see spu_run_frozen) that skip the
+ * input decimation and the reflection stage and loop the tail already in
+ * the work area, forwards or in reverse. Pending preset changes wait until
+ * the tail is thawed.
+ *
+ * set_param("snapshot", "take") copies the active work area into the next
+ * slot of a ring of PSXVERB_SNAPSHOT_SLOTS preallocated copies, with one
+ * memcpy on the audio thread; "recall [age]" copies the newest (or an older)
+ * one back, e.g. to replay it frozen in Reverse. The ring is allocated on
+ * the UI thread at the largest work area size in use and handed over like a
+ * spare core buffer; a larger ring starts out empty.
+ * ============================================================================ */
+
+enum {
+    FREEZE_OFF = 0,
+    FREEZE_LOOP,        /* Replay forwards */
+    FREEZE_REVERSE,     /* Replay backwards */
+    FREEZE_COUNT
+};
+
+static const char *const g_freeze_names[FREEZE_COUNT] = { "Off", "Loop", "Reverse" };
+
+/* UI side: make sure the ring can hold the largest work area requested so
+ * far. Returns 0 on success. */
+static int v2_reserve_ring(psxverb_instance_t *inst) {
+    v2_work_release(inst, atomic_exchange(&inst->ring_retired, NULL));
+    if (inst->ui_ring_slot >= inst->ui_work_max) return 0;
+
+    work_buf_t *w = v2_work_alloc(inst, inst->ui_work_max * PSXVERB_SNAPSHOT_SLOTS);
+    if (!w) {
+        fx_log("snapshot ring allocation failed");
+        return -1;
+    }
+    v2_work_release(inst, atomic_exchange(&inst->ring_next, w));
+    inst->ui_ring_slot = inst->ui_work_max;
+    return 0;
+}
+
+/* UI side: set_param("snapshot", "take" | "recall [age]") */
+static void v2_snapshot_param(psxverb_instance_t *inst, const char *val) {
+    if (strcmp(val, "take") == 0) {
+        if (v2_reserve_ring(inst) == 0) atomic_fetch_add(&inst->snap_take, 1);
+    } else if (strncmp(val, "recall", 6) == 0) {
+        int age = atoi(val + 6);
+        if (age >= 0 && age < PSXVERB_SNAPSHOT_SLOTS) {
+            atomic_store(&inst->snap_recall, (uint32_t)age + 1);
+        }
+    }
+}
+
+/* Audio side: swap in a new ring, then serve take and recall requests.
+ * At most one memcpy of the work area each, no allocation. */
+static void v2_service_snapshots(psxverb_instance_t *inst) {
+    if (atomic_load_explicit(&inst->ring_next, memory_order_relaxed) &&
+        !atomic_load_explicit(&inst->ring_retired, memory_order_relaxed)) {
+        work_buf_t *w = atomic_exchange(&inst->ring_next, NULL);
+        if (w) {
+            atomic_store(&inst->ring_retired, inst->ring);
+            inst->ring = w;
+            for (int i = 0; i < PSXVERB_SNAPSHOT_SLOTS; i++) inst->snap_preset[i] = -1;
+            atomic_store_explicit(&inst->snap_taken, 0, memory_order_relaxed);
+        }
+    }
+    work_buf_t *ring = inst->ring;
+    workarea_t *wa = &inst->core[inst->active].work;
+    uint32_t size = wa->size_mask + 1;
+    uint32_t slot = ring ? ring->capacity / PSXVERB_SNAPSHOT_SLOTS : 0;
+    uint32_t taken = atomic_load_explicit(&inst->snap_taken, memory_order_relaxed);
+
+    uint32_t req = atomic_load_explicit(&inst->snap_take, memory_order_relaxed);
+    if (req != inst->snap_seen) {
+        inst->snap_seen = req;
+        if (size <= slot) {
+            uint32_t i = taken % PSXVERB_SNAPSHOT_SLOTS;
+            memcpy(ring->data + i * slot, wa->buf, size * sizeof(int16_t));
+            inst->snap_preset[i] = inst->active_preset;
+            inst->snap_base[i] = wa->base;
+            atomic_store_explicit(&inst->snap_taken, ++taken, memory_order_relaxed);
+        }
+    }
+
+    if (!atomic_load_explicit(&inst->snap_recall, memory_order_relaxed)) return;
+    uint32_t age = atomic_exchange(&inst->snap_recall, 0) - 1;
+    if (age >= taken || age >= PSXVERB_SNAPSHOT_SLOTS) return;
+    uint32_t i = (taken - 1 - age) % PSXVERB_SNAPSHOT_SLOTS;
+    if (inst->snap_preset[i] != inst->active_preset) return;  /* Other tap layout */
+    memcpy(wa->buf, ring->data + i * slot, size * sizeof(int16_t));
+    memcpy(wa->buf + size, wa->buf, WORK_GUARD * sizeof(int16_t));
+    wa->base = inst->snap_base[i];
+    inst->sleeping = 0;
+    inst->quiet_ticks = 0;
+}
+
+/* ============================================================================
+ * PRESET SWITCHING
+ * set_param only publishes the new preset (and hands over a larger spare work
+ * area if needed). process_block picks it up at a block boundary: the spare
+ * core, already cleared, starts the new preset while the old core keeps
+ * running and fades out over crossfade_ms. The retired core is then zeroed a
+ * chunk per block, so no call ever pays for clearing 128 KB at once.
+ *
+ * Buffer ownership moves only by atomic exchange: the UI thread allocates
+ * into spare_next, the audio thread takes it and parks the replaced buffer
+ * in retired, and the UI thread frees that on its next call.
+ * ============================================================================ */
+
+#define WORK_CLEAR_CHUNK 4096   /* Samples zeroed per block on the idle core */
+#define CROSSFADE_MAX_MS 2000.0f
+
+
+static inline uint32_t spu_core_capacity(const spu_core_t *c) {
+    return c->mem ? c->mem->capacity : 0;
+}
+
+/* Point a core's work area at its buffer for a preset of `samples` */
+static void spu_core_start(spu_core_t *c, uint32_t samples) {
+    c->work.buf = c->mem->data;
+    c->work.size_mask = samples - 1;
+    c->work.base = 0;
+    c->clean = 0;
+}
+
+/* UI side: make sure whichever core ends up spare can hold `needed` samples.
+ * Returns 0 on success. */
+static int v2_reserve_spare(psxverb_instance_t *inst, uint32_t needed) {
+    /* Anything process_block swapped out since the last call */
+    v2_work_release(inst, atomic_exchange(&inst->retired, NULL));
+
+    if (needed > inst->ui_work_max) inst->ui_work_max = needed;
+    if (atomic_load(&inst->min_capacity) >= needed) return 0;
+
+    work_buf_t *pending = atomic_load(&inst->spare_next);
+    if (pending && pending->capacity >= needed) return 0;
+
+    /* Size for the largest preset seen so both cores converge on it */
+    work_buf_t *w = v2_work_alloc(inst, inst->ui_work_max);
+    if (!w) {
+        fx_log("work area allocation failed, keeping previous preset");
+        return -1;
+    }
+    v2_work_release(inst, atomic_exchange(&inst->spare_next, w));
+    return 0;
+}
+
+/* Clear the resampler histories of every bus: the decimators, and with
+ * `all` the interpolators too */
+static void v2_reset_filters(psxverb_instance_t *inst, int all) {
+    hb_decimator_init(&inst->down);
+    hb_mono_decimator_init(&inst->down_mono);
+    if (all) hb_interpolator_init(&inst->up);
+    for (int b = 0; b < inst->buses - 1; b++) {
+        hb_decimator_init(&inst->bus[b].down);
+        hb_mono_decimator_init(&inst->bus[b].down_mono);
+        if (all) hb_interpolator_init(&inst->bus[b].up);
+    }
+}
+
+/* Audio side: take a parameter snapshot if one was published */
+static void v2_consume_params(psxverb_instance_t *inst) {
+    const psxverb_params_t *p = mailbox_consume(&inst->mailbox);
+    if (!p) return;
+
+    int decay_changed = p->decay != inst->live.decay;
+    int gains_changed = p->input_gain != inst->live.input_gain ||
+                        p->reverb_level != inst->live.reverb_level;
+    int mix_changed = p->mix != inst->live.mix;
+    int preset_changed = p->preset != inst->live.preset;
+    int routing_changed = p->routing != inst->live.routing;
+    int resampler_changed = p->resampler != inst->live.resampler;
+    int thawed = p->freeze == FREEZE_OFF && inst->live.freeze != FREEZE_OFF;
+    int snap = !inst->started || p->restores != inst->live.restores;
+    inst->live = *p;
+
+    if (decay_changed) v2_update_decay(inst);
+    if (gains_changed) v2_update_gains(inst);
+    if (mix_changed) inst->params_dirty = 1;
+    if (snap) {
+        /* A fresh instance or a loaded patch starts at its values; only
+         * changes made while processing ramp */
+        v2_snap_volumes(inst);
+        inst->mix_cur = inst->live.mix;
+        inst->params_dirty = 0;
+        inst->ramp_remaining = 0;
+    }
+    if (routing_changed || thawed) {
+        /* The decimator that was idle holds stale history */
+        v2_reset_filters(inst, 0);
+    }
+    if (resampler_changed) {
+        /* Filter histories are laid out per kernel length */
+        v2_reset_filters(inst, 1);
+    }
+    if (preset_changed) {
+        inst->pending_preset = (p->preset != inst->active_preset) ? p->preset : -1;
+    }
+}
+
+static void v2_update_min_capacity(psxverb_instance_t *inst) {
+    uint32_t a = spu_core_capacity(&inst->core[0]);
+    uint32_t b = spu_core_capacity(&inst->core[1]);
+    atomic_store(&inst->min_capacity, a < b ? a : b);
+}
+
+/* Audio side: copy the active work area into the buffer the UI asked for
+ * (get_param("state_bin")). One memcpy, no allocation. */
+static void v2_service_capture(psxverb_instance_t *inst) {
+    if (!atomic_load_explicit(&inst->capture_req, memory_order_relaxed)) return;
+    work_buf_t *w = atomic_exchange(&inst->capture_req, NULL);
+    if (!w) return;
+    const workarea_t *wa = &inst->core[inst->active].work;
+    uint32_t size = wa->size_mask + 1;
+    w->state_preset = -1;
+    if (w->capacity >= size) {
+        memcpy(w->data, wa->buf, size * sizeof(int16_t));
+        w->state_preset = inst->active_preset;
+        w->state_base = wa->base;
+    }
+    atomic_store(&inst->capture_done, w);
+}
+
+/* Audio side: resume from a restored work area (set_param("state_bin"))
+ * in place of the active core, at the restored parameters with no ramp.
+ * Any crossfade is cut; the replaced buffer goes back through retired, so
+ * this waits until that slot is free. */
+static void v2_apply_restore(psxverb_instance_t *inst) {
+    if (!atomic_load_explicit(&inst->restore_next, memory_order_relaxed) ||
+        atomic_load_explicit(&inst->retired, memory_order_relaxed)) {
+        return;
+    }
+    work_buf_t *w = atomic_exchange(&inst->restore_next, NULL);
+    if (!w) return;
+    v2_consume_params(inst);    /* Published before w */
+    spu_core_t *c = &inst->core[inst->active];
+    int idx = w->state_preset;
+    atomic_store(&inst->retired, c->mem);
+    c->mem = w;
+    v2_update_min_capacity(inst);
+    spu_core_start(c, inst->rates->work_samples[idx]);
+    c->work.base = w->state_base;
+
+    v2_load_preset(inst, idx);
+    inst->mix_cur = inst->live.mix;
+    inst->params_dirty = 0;
+    inst->fade_remaining = 0;
+    if (inst->pending_preset == idx) inst->pending_preset = -1;
+    inst->sleeping = 0;
+    inst->quiet_ticks = 0;
+}
+
+/* Audio side: handoffs and housekeeping for the idle core, then start a
+ * pending preset once the spare is free and clean and the tail is not
+ * frozen. Allocation-free. */
+static void v2_update_cores(psxverb_instance_t *inst) {
+    v2_service_capture(inst);
+    v2_apply_restore(inst);
+    v2_service_snapshots(inst);
+    if (inst->fade_remaining > 0) return;  /* Old tail still fading out */
+
+    spu_core_t *spare = &inst->core[inst->active ^ 1];
+
+    /* Swap in a larger buffer, but only once the previous one was collected */
+    if (atomic_load_explicit(&inst->spare_next, memory_order_relaxed) &&
+        !atomic_load_explicit(&inst->retired, memory_order_relaxed)) {
+        work_buf_t *w = atomic_exchange(&inst->spare_next, NULL);
+        if (w) {
+            atomic_store(&inst->retired, spare->mem);
+            spare->mem = w;
+            spare->clean = w->capacity + WORK_GUARD;
+            v2_update_min_capacity(inst);
+        }
+    }
+
+    uint32_t capacity = spu_core_capacity(spare);
+    if (spare->mem && spare->clean < capacity + WORK_GUARD) {
+        uint32_t n = capacity + WORK_GUARD - spare->clean;
+        if (n > WORK_CLEAR_CHUNK) n = WORK_CLEAR_CHUNK;
+        memset(spare->mem->data + spare->clean * inst->lanes, 0, n * inst->lanes * sizeof(int16_t));
+        spare->clean += n;
+    }
+
+    int idx = inst->pending_preset;
+    if (idx < 0 || inst->live.freeze != FREEZE_OFF) return;  /* Frozen: wait for the thaw */
+    uint32_t needed = inst->rates->work_samples[idx];
+    if (capacity < needed || spare->clean < needed + WORK_GUARD) return;
+
+    inst->pending_preset = -1;
+    inst->fade_preset = inst->current;
+    inst->fade_index = inst->active_preset;
+    v2_load_preset(inst, idx);
+    spu_core_start(spare, needed);
+    inst->active ^= 1;
+
+    inst->fade_ticks = (uint32_t)(inst->live.crossfade_ms * (float)(inst->sample_rate / 2) / 1000.0f);
+    inst->fade_remaining = inst->started ? inst->fade_ticks : 0;  /* No tail before the first block */
+}
+
+/* ============================================================================
+ * INSTANCE POOL
+ * Chains often run several instances back to back. Their state lives in one
+ * static, cache-aligned arena so consecutive process_block calls walk
+ * adjacent memory instead of scattered heap blocks. Instances beyond the
+ * pool fall back to calloc. Build with -DPSXVERB_POOL_SLOTS=0 to disable.
+ *
+ * The pool shares memory only; each instance still runs on its own. Batching
+ * across instances would have to hold every block back until all of them
+ * had delivered theirs, a block of latency that breaks Insert routing and
+ * instances in series. Tracks that share settings batch through one
+ * multi-bus instance instead (see MULTI-BUS).
+ * ============================================================================ */
+
+#ifndef PSXVERB_POOL_SLOTS
+#define PSXVERB_POOL_SLOTS 8
+#endif
+
+#if PSXVERB_POOL_SLOTS > 0
+typedef struct {
+    _Alignas(WORK_ALIGN) psxverb_instance_t inst;
+} pool_slot_t;
+
+static pool_slot_t g_pool[PSXVERB_POOL_SLOTS];
+static uint8_t g_pool_used[PSXVERB_POOL_SLOTS];
+static atomic_flag g_pool_lock = ATOMIC_FLAG_INIT;
+#endif
+
+/* Zeroed instance storage, from the pool when a slot is free */
+static psxverb_instance_t *instance_alloc(void) {
+#if PSXVERB_POOL_SLOTS > 0
+    psxverb_instance_t *inst = NULL;
+    while (atomic_flag_test_and_set_explicit(&g_pool_lock, memory_order_acquire)) {}
+    for (int i = 0; i < PSXVERB_POOL_SLOTS; i++) {
+        if (!g_pool_used[i]) {
+            g_pool_used[i] = 1;
+            inst = &g_pool[i].inst;
+            break;
+        }
+    }
+    atomic_flag_clear_explicit(&g_pool_lock, memory_order_release);
+    if (inst) {
+        memset(inst, 0, sizeof(*inst));
+        return inst;
+    }
+#endif
+    return (psxverb_instance_t*)calloc(1, sizeof(psxverb_instance_t));
+}
+
+static void instance_free(psxverb_instance_t *inst) {
+    free(inst->bus);
+#if PSXVERB_POOL_SLOTS > 0
+    pool_slot_t *slot = (pool_slot_t*)inst;
+    if (slot >= g_pool && slot < g_pool + PSXVERB_POOL_SLOTS) {
+        while (atomic_flag_test_and_set_explicit(&g_pool_lock, memory_order_acquire)) {}
+        g_pool_used[slot - g_pool] = 0;
+        atomic_flag_clear_explicit(&g_pool_lock, memory_order_release);
+        return;
+    }
+#endif
+    free(inst);
+}
+
+/* Bus count from config_json {"buses": K}, and the per-bus filters.
+ * Anything else, or no config, is a plain stereo instance. */
+static int v2_init_buses(psxverb_instance_t *inst, const char *config_json) {
+    const char *k = config_json ? strstr(config_json, "\"buses\"") : NULL;
+    int buses = 1;
+    if (k && (k = strchr(k, ':')) != NULL) buses = atoi(k + 1);
+    if (buses < 1 || buses > PSXVERB_MAX_BUSES) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "buses must be 1-%d, using 1", PSXVERB_MAX_BUSES);
+        fx_log(msg);
+        buses = 1;
+    }
+    inst->buses = buses;
+    inst->lanes = 1;
+    if (buses == 1) return 0;
+
+    inst->lanes = (uint32_t)(buses + SPU_BUS_LANES - 1) & ~(uint32_t)(SPU_BUS_LANES - 1);
+    inst->bus = (bus_filters_t*)calloc((size_t)(buses - 1), sizeof(bus_filters_t));
+    return inst->bus ? 0 : -1;
+}
+
+/* v2 API: create instance */
+static void* v2_create_instance(const char *module_dir, const char *config_json) {
+    psxverb_instance_t *inst = instance_alloc();
+    if (!inst) return NULL;
+
+    /* Host sample rate, falling back to the Move default */
+    int rate = (g_host && g_host->sample_rate > 0) ? g_host->sample_rate : MOVE_SAMPLE_RATE;
+    if (rate < MIN_SAMPLE_RATE || rate > MAX_SAMPLE_RATE) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "unsupported sample rate %d, using %d", rate, MOVE_SAMPLE_RATE);
+        fx_log(msg);
+        rate = MOVE_SAMPLE_RATE;
+    }
+    inst->sample_rate = rate;
+    if (v2_init_buses(inst, config_json) != 0) {
+        instance_free(inst);
+        return NULL;
+    }
+    preset_list_init(module_dir);
+    inst->rates = rate_table_get(rate);
+    if (!inst->rates) {
+        fx_log("sample rate table cache full");
+        instance_free(inst);
+        return NULL;
+    }
+
+    /* Initialize state */
+    inst->ui.preset = 4;            /* Default: Hall */
+    inst->ui.decay = 0.7f;          /* With formula 0.5+(d*0.5), 0.7 gives 0.85x wall feedback */
+    inst->ui.mix = 0.35f;
+    inst->ui.input_gain = 0.5f;
+    inst->ui.reverb_level = 0.5f;
+    inst->ui.crossfade_ms = 200.0f;
+    inst->live = inst->ui;
+    inst->pending_preset = -1;
+    mailbox_init(&inst->mailbox, &inst->ui);
+
+    /* Initialize halfband filters */
+    v2_reset_filters(inst, 1);
+
+    /* Default preset on core 0; core 1 is allocated on the first preset change */
+    uint32_t samples = inst->rates->work_samples[inst->ui.preset];
+    spu_core_t *c = &inst->core[0];
+    c->mem = v2_work_alloc(inst, samples);
+    if (!c->mem) {
+        instance_free(inst);
+        return NULL;
+    }
+    spu_core_start(c, samples);
+    inst->ui_work_max = samples;
+    atomic_init(&inst->spare_next, NULL);
+    atomic_init(&inst->retired, NULL);
+    atomic_init(&inst->min_capacity, 0);
+    atomic_init(&inst->carry_latency, 0);
+    atomic_init(&inst->denormal_chunks, 0);
+    atomic_init(&inst->restore_next, NULL);
+    atomic_init(&inst->capture_req, NULL);
+    atomic_init(&inst->capture_done, NULL);
+    atomic_init(&inst->ring_next, NULL);
+    atomic_init(&inst->ring_retired, NULL);
+    atomic_init(&inst->snap_take, 0);
+    atomic_init(&inst->snap_recall, 0);
+    atomic_init(&inst->snap_taken, 0);
+    atomic_init(&inst->meters.seq, 0);
+    for (int i = 0; i < METER_COUNT; i++) atomic_init(&inst->meters.v[i], 0.0f);
+
+    v2_load_preset(inst, inst->ui.preset);
+    inst->fade_index = inst->active_preset;
+    inst->mix_cur = inst->live.mix;
+    inst->params_dirty = 0;
+
+    fx_log("PSX Verb v2 instance created");
+    return inst;
+}
+
+/* v2 API: destroy instance */
+static void v2_destroy_instance(void *instance) {
+    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
+    if (!inst) return;
+
+    v2_work_release(inst, inst->core[0].mem);
+    v2_work_release(inst, inst->core[1].mem);
+    v2_work_release(inst, atomic_load(&inst->spare_next));
+    v2_work_release(inst, atomic_load(&inst->retired));
+    v2_work_release(inst, atomic_load(&inst->restore_next));
+    v2_work_release(inst, atomic_load(&inst->capture_req));
+    v2_work_release(inst, atomic_load(&inst->capture_done));
+    v2_work_release(inst, inst->ring);
+    v2_work_release(inst, atomic_load(&inst->ring_next));
+    v2_work_release(inst, atomic_load(&inst->ring_retired));
+    instance_free(inst);
+    fx_log("PSX Verb v2 instance destroyed");
+}
+
+/* ============================================================================
+ * BLOCK PIPELINE
+ * process_block runs in staged passes over at most one host block
+ * (MOVE_FRAMES_PER_BLOCK frames = BLOCK_TICKS SPU ticks) at a time:
+ *   int16 -> float, decimate, SPU core, interpolate, mix -> int16
+ * Each pass is a tight loop over planar scratch buffers that stay in L1.
+ * The host buffer is a block_io_t: for process_block_f32 with planar
+ * channels, passes 1 and 5 read and write the host buffers directly.
+ * ============================================================================ */
+
+#define BLOCK_FRAMES MOVE_FRAMES_PER_BLOCK
+#define BLOCK_TICKS (BLOCK_FRAMES / 2)
+
+_Static_assert(BLOCK_TICKS <= WORK_GUARD, "kernel calls must fit in the work area guard");
+
+typedef struct {
+    float in_l[BLOCK_FRAMES], in_r[BLOCK_FRAMES];     /* Dry input */
+    float wet_l[BLOCK_FRAMES], wet_r[BLOCK_FRAMES];   /* Interpolated wet */
+    float tick_l[BLOCK_TICKS], tick_r[BLOCK_TICKS];   /* SPU rate in/out */
+    float fade_l[BLOCK_TICKS], fade_r[BLOCK_TICKS];   /* Outgoing core during a crossfade */
+} block_scratch_t;
+
+/* Pass 1: interleaved int16 -> planar float (x / 32768, exact) */
+static void block_to_float(const int16_t *src, float *l, float *r, int frames) {
+    int i = 0;
+#if PSXVERB_USE_NEON
+    const float k = 1.0f / 32768.0f;
+    for (; i + 8 <= frames; i += 8) {
+        int16x8x2_t v = vld2q_s16(src + i * 2);
+        vst1q_f32(l + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v.val[0]))), k));
+        vst1q_f32(l + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v.val[0]))), k));
+        vst1q_f32(r + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v.val[1]))), k));
+        vst1q_f32(r + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v.val[1]))), k));
+    }
+#endif
+    for (; i < frames; i++) {
+        l[i] = src[i * 2] / 32768.0f;
+        r[i] = src[i * 2 + 1] / 32768.0f;
+    }
+}
+
+/* Planar float -> interleaved int16, clamped to [-1, 1], scaled by 32767 and
+ * truncated like the (int16_t) cast */
+static void block_store_int16(const float *l, const float *r, int16_t *dst, int frames) {
+    int i = 0;
+#if PSXVERB_PROFILE
+    for (int j = 0; j < frames; j++) {
+        PERF_COUNT(t_perf_clips, abs_f(l[j]) > 1.0f);
+        PERF_COUNT(t_perf_clips, abs_f(r[j]) > 1.0f);
+    }
+#endif
+#if PSXVERB_USE_NEON
+    const float32x4_t lo = vdupq_n_f32(-1.0f);
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+#define STORE_LANE4(src) \
+    vmovn_s32(vcvtq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(src), lo), hi), 32767.0f)))
+    for (; i + 8 <= frames; i += 8) {
+        int16x8x2_t v;
+        v.val[0] = vcombine_s16(STORE_LANE4(l + i), STORE_LANE4(l + i + 4));
+        v.val[1] = vcombine_s16(STORE_LANE4(r + i), STORE_LANE4(r + i + 4));
+        vst2q_s16(dst + i * 2, v);
+    }
+#undef STORE_LANE4
+#endif
+    for (; i < frames; i++) {
+        dst[i * 2] = (int16_t)(clamp_f(l[i], -1.0f, 1.0f) * 32767.0f);
+        dst[i * 2 + 1] = (int16_t)(clamp_f(r[i], -1.0f, 1.0f) * 32767.0f);
+    }
+}
+
+/* Host buffer of one process call. int16 is interleaved; float channels
+ * are addressed with a sample stride, 1 for planar buffers and 2 for
+ * interleaved ones (r = l + 1). Float samples are full scale at 1.0. */
+typedef struct {
+    int16_t *i16;   /* Interleaved int16, or NULL for float */
+    float *l, *r;
+    int stride;
+} block_io_t;
+
+static inline block_io_t io_int16(int16_t *buf) {
+    block_io_t io = {buf, NULL, NULL, 2};
+    return io;
+}
+
+static inline block_io_t io_f32(float *l, float *r, int stride) {
+    block_io_t io = {NULL, l, r, stride};
+    return io;
+}
+
+/* Pass 1 for frames [off, off + n): the dry input as planar float. Planar
+ * float input is used where it is; anything else is converted into l/r. */
+static void io_load(const block_io_t *io, int off, int n, float *l, float *r,
+                    const float **dry_l, const float **dry_r) {
+    if (io->i16) {
+        block_to_float(io->i16 + off * 2, l, r, n);
+    } else if (io->stride == 1) {
+        *dry_l = io->l + off;
+        *dry_r = io->r + off;
+        return;
+    } else {
+        const float *sl = io->l + off * io->stride, *sr = io->r + off * io->stride;
+        for (int i = 0; i < n; i++) {
+            l[i] = sl[i * io->stride];
+            r[i] = sr[i * io->stride];
+        }
+    }
+    *dry_l = l;
+    *dry_r = r;
+}
+
+/* Where pass 5 writes frames from off: straight into planar float host
+ * buffers, otherwise into the scratch l/r that io_store converts from */
+static inline void io_out(const block_io_t *io, int off, float *l, float *r,
+                          float **out_l, float **out_r) {
+    if (!io->i16 && io->stride == 1) {
+        *out_l = io->l + off;
+        *out_r = io->r + off;
+    } else {
+        *out_l = l;
+        *out_r = r;
+    }
+}
+
+/* Store pass 5 output for frames [off, off + n). Float output is not
+ * clamped, and is already in place when l is the planar host buffer. */
+static void io_store(const block_io_t *io, int off, const float *l, const float *r, int n) {
+    if (io->i16) {
+        block_store_int16(l, r, io->i16 + off * 2, n);
+        return;
+    }
+    float *dl = io->l + off * io->stride, *dr = io->r + off * io->stride;
+    if (dl == l) return;
+    for (int i = 0; i < n; i++) {
+        dl[i * io->stride] = l[i];
+        dr[i * io->stride] = r[i];
+    }
+}
+
+/* Any non-zero input sample in the first `frames` frames */
+static int io_active(const block_io_t *io, int frames) {
+    if (io->i16) {
+        for (int i = 0; i < frames * 2; i++) {
+            if (io->i16[i] != 0) return 1;
+        }
+        return 0;
+    }
+    for (int i = 0; i < frames; i++) {
+        if (io->l[i * io->stride] != 0.0f || io->r[i * io->stride] != 0.0f) return 1;
+    }
+    return 0;
+}
+
+/* One frame in io units (int16 values are exact in float), for carry mode */
+static inline void io_get_frame(const block_io_t *io, int i, float v[2]) {
+    if (io->i16) {
+        v[0] = io->i16[i * 2];
+        v[1] = io->i16[i * 2 + 1];
+    } else {
+        v[0] = io->l[i * io->stride];
+        v[1] = io->r[i * io->stride];
+    }
+}
+
+static inline void io_put_frame(const block_io_t *io, int i, const float v[2]) {
+    if (io->i16) {
+        io->i16[i * 2] = (int16_t)v[0];
+        io->i16[i * 2 + 1] = (int16_t)v[1];
+    } else {
+        io->l[i * io->stride] = v[0];
+        io->r[i * io->stride] = v[1];
+    }
+}
+
+/* Copy n frames between two buffers of the same sample type */
+static void io_copy(const block_io_t *dst, int dst_off, const block_io_t *src, int src_off, int n) {
+    if (dst->i16) {
+        memcpy(dst->i16 + dst_off * 2, src->i16 + src_off * 2, (size_t)n * 2 * sizeof(int16_t));
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        dst->l[(dst_off + i) * dst->stride] = src->l[(src_off + i) * src->stride];
+        dst->r[(dst_off + i) * dst->stride] = src->r[(src_off + i) * src->stride];
+    }
+}
+
+/* Pass 2 (2:1 decimation into tick buffers) and pass 4 (1:2 interpolation)
+ * are picked per block from the RESAMPLERS table below */
+
+/* Preset specialization for spu_run: SPU_GENERIC reads everything from p;
+ * a literal preset index turns its fixed coefficients into constants and
+ * drops the taps they make dead (see ENGINE DISPATCH). Offsets stay in the
+ * tap program since they scale with the host rate, and are resolved once
+ * per call anyway. */
+#define SPU_GENERIC (-1)
+#define SPU_FIXED(preset) g_presets[(preset) < 0 ? 0 : (preset)]
+#define SPU_COEF(preset, v) ((preset) < 0 ? p->v##_f : coeff_to_float(SPU_FIXED(preset).v))
+#define SPU_HAS_COMB(preset, n) ((preset) < 0 || SPU_FIXED(preset).vCOMB##n != 0)
+#define SPU_HAS_DIFF(preset) ((preset) < 0 || (SPU_FIXED(preset).mLDIFF | SPU_FIXED(preset).mRDIFF | \
+                                               SPU_FIXED(preset).dLDIFF | SPU_FIXED(preset).dRDIFF) != 0)
+
+/* Pass 3: PSX SPU reverb core, one tick per sample pair.
+ * Input volume is applied on entry, output volume on exit; out may alias in.
+ * With a non-NULL step the smoothed volumes advance every tick and are
+ * written back to p; callers pass a literal NULL for the static case so the
+ * ramp code compiles out of that specialization entirely. preset is
+ * SPU_GENERIC or a literal index, as above. */
+static inline __attribute__((always_inline))
+void spu_run(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+             const float *in_l, const float *in_r,
+             float *out_l, float *out_r, int ticks, int preset) {
+    const float vIIR = SPU_COEF(preset, vIIR);
+    const float vCOMB1 = SPU_COEF(preset, vCOMB1), vCOMB2 = SPU_COEF(preset, vCOMB2);
+    const float vCOMB3 = SPU_COEF(preset, vCOMB3), vCOMB4 = SPU_COEF(preset, vCOMB4);
+    const float vAPF1 = SPU_COEF(preset, vAPF1), vAPF2 = SPU_COEF(preset, vAPF2);
+    float vWALL = p->vWALL_f;
+    float vLIN = p->vLIN_f, vRIN = p->vRIN_f;
+    float vLOUT = p->vLOUT_f, vROUT = p->vROUT_f;
+
+    /* Resolve every tap once; the guard region keeps them linear for the call */
+    const int16_t *buf = wa->buf;
+    uint32_t ix[TAP_COUNT];
+    for (int i = 0; i < TAP_COUNT; i++) ix[i] = (wa->base + p->taps.off[i]) & wa->size_mask;
+#define RD(tap) ((float)buf[ix[tap] + t] * kInt16ToFloat)
+#define WR(tap, v) workarea_store(wa, ix[tap] + t, workarea_sat(v))
+
+    for (int t = 0; t < ticks; t++) {
+        float Lin = in_l[t] * vLIN;
+        float Rin = in_r[t] * vRIN;
+
+        /* Same-side reflection */
+        float lsame_fb = RD(TAP_FB + 0);
+        float lsame_iir = RD(TAP_HIST + 0);
+        float lsame_out = (Lin + lsame_fb * vWALL - lsame_iir) * vIIR + lsame_iir;
+        WR(TAP_REFL + 0, lsame_out);
+
+        float rsame_fb = RD(TAP_FB + 1);
+        float rsame_iir = RD(TAP_HIST + 1);
+        float rsame_out = (Rin + rsame_fb * vWALL - rsame_iir) * vIIR + rsame_iir;
+        WR(TAP_REFL + 1, rsame_out);
+
+        /* Different-side reflection (left out where taps_diff_dead holds) */
+        if (SPU_HAS_DIFF(preset)) {
+            float ldiff_fb = RD(TAP_FB + 2);
+            float ldiff_iir = RD(TAP_HIST + 2);
+            float ldiff_out = (Lin + ldiff_fb * vWALL - ldiff_iir) * vIIR + ldiff_iir;
+            WR(TAP_REFL + 2, ldiff_out);
+
+            float rdiff_fb = RD(TAP_FB + 3);
+            float rdiff_iir = RD(TAP_HIST + 3);
+            float rdiff_out = (Rin + rdiff_fb * vWALL - rdiff_iir) * vIIR + rdiff_iir;
+            WR(TAP_REFL + 3, rdiff_out);
+        }
+
+        /* Comb filter bank; a zero coefficient only adds +-0 */
+        float Lout = vCOMB1 * RD(TAP_COMB + 0) + vCOMB2 * RD(TAP_COMB + 2);
+        float Rout = vCOMB1 * RD(TAP_COMB + 1) + vCOMB2 * RD(TAP_COMB + 3);
+        if (SPU_HAS_COMB(preset, 3)) {
+            Lout += vCOMB3 * RD(TAP_COMB + 4);
+            Rout += vCOMB3 * RD(TAP_COMB + 5);
+        }
+        if (SPU_HAS_COMB(preset, 4)) {
+            Lout += vCOMB4 * RD(TAP_COMB + 6);
+            Rout += vCOMB4 * RD(TAP_COMB + 7);
+        }
+
+        /* All-pass filter 1 */
+        float lapf1_del = RD(TAP_APF_DEL + 0);
+        Lout -= vAPF1 * lapf1_del;
+        WR(TAP_APF + 0, Lout);
+        Lout = Lout * vAPF1 + lapf1_del;
+
+        float rapf1_del = RD(TAP_APF_DEL + 1);
+        Rout -= vAPF1 * rapf1_del;
+        WR(TAP_APF + 1, Rout);
+        Rout = Rout * vAPF1 + rapf1_del;
+
+        /* All-pass filter 2 */
+        float lapf2_del = RD(TAP_APF_DEL + 2);
+        Lout -= vAPF2 * lapf2_del;
+        WR(TAP_APF + 2, Lout);
+        Lout = Lout * vAPF2 + lapf2_del;
+
+        float rapf2_del = RD(TAP_APF_DEL + 3);
+        Rout -= vAPF2 * rapf2_del;
+        WR(TAP_APF + 3, Rout);
+        Rout = Rout * vAPF2 + rapf2_del;
+
+        out_l[t] = Lout * vLOUT;
+        out_r[t] = Rout * vROUT;
+
+        if (step) {
+            vWALL += step->vWALL;
+            vLIN += step->vLIN;
+            vRIN += step->vRIN;
+            vLOUT += step->vLOUT;
+            vROUT += step->vROUT;
+        }
+    }
+#undef RD
+#undef WR
+    workarea_advance(wa, (uint32_t)ticks);
+
+    if (step) {
+        p->vWALL_f = vWALL;
+        p->vLIN_f = vLIN;
+        p->vRIN_f = vRIN;
+        p->vLOUT_f = vLOUT;
+        p->vROUT_f = vROUT;
+    }
+}
+
+/* SPU_BUS_LANES floats side by side: consecutive ticks of one SPU in
+ * spu_run_multi, one tick of several buses in the multi-bus kernel */
+#if PSXVERB_USE_NEON
+typedef float32x4_t lanes_t;
+
+static inline lanes_t lanes_load(const float *p) { return vld1q_f32(p); }
+static inline void lanes_store(float *p, lanes_t v) { vst1q_f32(p, v); }
+static inline lanes_t lanes_add(lanes_t a, lanes_t b) { return vaddq_f32(a, b); }
+static inline lanes_t lanes_sub(lanes_t a, lanes_t b) { return vsubq_f32(a, b); }
+static inline lanes_t lanes_scale(lanes_t a, float k) { return vmulq_n_f32(a, k); }
+
+/* SPU_BUS_LANES consecutive work area samples as float */
+static inline lanes_t lanes_read(const int16_t *p) {
+    return vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(p))), kInt16ToFloat);
+}
+
+static inline void lanes_sat(lanes_t v, int16_t *q) {
+    vst1_s16(q, vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(v, kFloatToInt16))));
+#if PSXVERB_PROFILE
+    float tmp[SPU_BUS_LANES];
+    vst1q_f32(tmp, v);
+    for (int i = 0; i < SPU_BUS_LANES; i++) (void)workarea_sat(tmp[i]);
+#endif
+}
+#else
+typedef struct { float v[SPU_BUS_LANES]; } lanes_t;
+
+#define LANES_OP(name, expr)                                                    \
+    static inline lanes_t name(lanes_t a, lanes_t b) {                          \
+        lanes_t r;                                                              \
+        for (int i = 0; i < SPU_BUS_LANES; i++) r.v[i] = (expr);                \
+        return r;                                                               \
+    }
+LANES_OP(lanes_add, a.v[i] + b.v[i])
+LANES_OP(lanes_sub, a.v[i] - b.v[i])
+#undef LANES_OP
+
+static inline lanes_t lanes_load(const float *p) {
+    lanes_t r;
+    memcpy(r.v, p, sizeof(r.v));
+    return r;
+}
+static inline void lanes_store(float *p, lanes_t v) { memcpy(p, v.v, sizeof(v.v)); }
+static inline lanes_t lanes_scale(lanes_t a, float k) {
+    for (int i = 0; i < SPU_BUS_LANES; i++) a.v[i] *= k;
+    return a;
+}
+static inline lanes_t lanes_read(const int16_t *p) {
+    lanes_t r;
+    for (int i = 0; i < SPU_BUS_LANES; i++) r.v[i] = (float)p[i] * kInt16ToFloat;
+    return r;
+}
+static inline void lanes_sat(lanes_t v, int16_t *q) {
+    for (int i = 0; i < SPU_BUS_LANES; i++) q[i] = workarea_sat(v.v[i]);
+}
+#endif
+
+#define SPU_MULTI_TICKS SPU_BUS_LANES
+
+/* Build with -DPSXVERB_NO_MULTI_TICK to run every tick through spu_run, e.g.
+ * to check spu_run_multi against it */
+#ifdef PSXVERB_NO_MULTI_TICK
+#define PSXVERB_MULTI_TICK 0
+#else
+#define PSXVERB_MULTI_TICK 1
+#endif
+
+/* workarea_sat + workarea_store for SPU_MULTI_TICKS consecutive positions */
+static inline void workarea_store_ticks(workarea_t *wa, uint32_t pos, lanes_t v) {
+    int16_t q[SPU_MULTI_TICKS];
+    lanes_sat(v, q);
+    pos &= wa->size_mask;
+    if (pos >= WORK_GUARD && pos + SPU_MULTI_TICKS <= wa->size_mask + 1) {
+        memcpy(wa->buf + pos, q, sizeof(q));
+        return;
+    }
+    for (int i = 0; i < SPU_MULTI_TICKS; i++) workarea_store(wa, pos + i, q[i]);
+}
+
+/* Multi-tick spu_run (static volumes only) for presets whose lookahead
+ * allows SPU_MULTI_TICKS ticks per batch. Feedback reads, the comb bank and
+ * both all-pass stages run SPU_MULTI_TICKS ticks per lanes op; only the
+ * reflection IIR recursion is evaluated tick by tick. Comb taps flagged in
+ * taps.comb_early are read before it (see g_tap_schedule) and a dead DIFF
+ * reflection is skipped. Handles whole batches and returns the number of
+ * ticks done. */
+static int spu_run_multi(workarea_t *wa, const scaled_preset_t *p,
+                         const float *in_l, const float *in_r,
+                         float *out_l, float *out_r, int ticks) {
+    const int16_t *buf = wa->buf;
+    uint32_t ix[TAP_COUNT];
+    for (int i = 0; i < TAP_COUNT; i++) ix[i] = (wa->base + p->taps.off[i]) & wa->size_mask;
+
+    const float iir = p->vIIR_f;
+    const uint32_t early = p->taps.comb_early;
+    const int refls = p->taps.diff_dead ? 2 : 4;
+    int t = 0;
+    for (; t + SPU_MULTI_TICKS <= ticks; t += SPU_MULTI_TICKS) {
+        lanes_t lin = lanes_scale(lanes_load(in_l + t), p->vLIN_f);
+        lanes_t rin = lanes_scale(lanes_load(in_r + t), p->vRIN_f);
+
+        /* Reflection inputs: in + fb * vWALL for {LSAME, RSAME, LDIFF, RDIFF} */
+        float x[4][SPU_MULTI_TICKS];
+        for (int i = 0; i < refls; i++) {
+            lanes_t fb = lanes_scale(lanes_read(buf + ix[TAP_FB + i] + t), p->vWALL_f);
+            lanes_store(x[i], lanes_add(i & 1 ? rin : lin, fb));
+        }
+
+        lanes_t comb[8];
+        for (int i = 0; i < 8; i++) {
+            if (early & (1u << i)) comb[i] = lanes_read(buf + ix[TAP_COMB + i] + t);
+        }
+
+        /* IIR: history is the previous tick's output, so tick by tick */
+        for (int j = 0; j < SPU_MULTI_TICKS; j++) {
+            uint32_t u = (uint32_t)(t + j);
+            for (int i = 0; i < refls; i++) {
+                float h = (float)buf[ix[TAP_HIST + i] + u] * kInt16ToFloat;
+                workarea_store(wa, ix[TAP_REFL + i] + u, workarea_sat((x[i][j] - h) * iir + h));
+            }
+        }
+
+        /* Comb filter bank */
+        for (int i = 0; i < 8; i++) {
+            if (!(early & (1u << i))) comb[i] = lanes_read(buf + ix[TAP_COMB + i] + t);
+        }
+        lanes_t lout = lanes_scale(comb[0], p->vCOMB1_f);
+        lout = lanes_add(lout, lanes_scale(comb[2], p->vCOMB2_f));
+        lout = lanes_add(lout, lanes_scale(comb[4], p->vCOMB3_f));
+        lout = lanes_add(lout, lanes_scale(comb[6], p->vCOMB4_f));
+        lanes_t rout = lanes_scale(comb[1], p->vCOMB1_f);
+        rout = lanes_add(rout, lanes_scale(comb[3], p->vCOMB2_f));
+        rout = lanes_add(rout, lanes_scale(comb[5], p->vCOMB3_f));
+        rout = lanes_add(rout, lanes_scale(comb[7], p->vCOMB4_f));
+
+        /* All-pass filters 1 and 2 */
+        lanes_t del = lanes_read(buf + ix[TAP_APF_DEL + 0] + t);
+        lout = lanes_sub(lout, lanes_scale(del, p->vAPF1_f));
+        workarea_store_ticks(wa, ix[TAP_APF + 0] + t, lout);
+        lout = lanes_add(lanes_scale(lout, p->vAPF1_f), del);
+
+        del = lanes_read(buf + ix[TAP_APF_DEL + 1] + t);
+        rout = lanes_sub(rout, lanes_scale(del, p->vAPF1_f));
+        workarea_store_ticks(wa, ix[TAP_APF + 1] + t, rout);
+        rout = lanes_add(lanes_scale(rout, p->vAPF1_f), del);
+
+        del = lanes_read(buf + ix[TAP_APF_DEL + 2] + t);
+        lout = lanes_sub(lout, lanes_scale(del, p->vAPF2_f));
+        workarea_store_ticks(wa, ix[TAP_APF + 2] + t, lout);
+        lout = lanes_add(lanes_scale(lout, p->vAPF2_f), del);
+
+        del = lanes_read(buf + ix[TAP_APF_DEL + 3] + t);
+        rout = lanes_sub(rout, lanes_scale(del, p->vAPF2_f));
+        workarea_store_ticks(wa, ix[TAP_APF + 3] + t, rout);
+        rout = lanes_add(lanes_scale(rout, p->vAPF2_f), del);
+
+        lanes_store(out_l + t, lanes_scale(lout, p->vLOUT_f));
+        lanes_store(out_r + t, lanes_scale(rout, p->vROUT_f));
+    }
+    workarea_advance(wa, (uint32_t)t);
+    return t;
+}
+
+static inline __attribute__((always_inline))
+void spu_process_ticks_preset(workarea_t *wa, scaled_preset_t *p,
+                              const float *in_l, const float *in_r,
+                              float *out_l, float *out_r, int ticks, int preset) {
+    if (PSXVERB_MULTI_TICK && p->taps.lookahead >= SPU_MULTI_TICKS) {
+        int done = spu_run_multi(wa, p, in_l, in_r, out_l, out_r, ticks);
+        in_l += done; in_r += done;
+        out_l += done; out_r += done;
+        ticks -= done;
+    }
+    spu_run(wa, p, NULL, in_l, in_r, out_l, out_r, ticks, preset);
+}
+
+static void spu_process_ticks(workarea_t *wa, scaled_preset_t *p,
+                              const float *in_l, const float *in_r,
+                              float *out_l, float *out_r, int ticks) {
+    spu_process_ticks_preset(wa, p, in_l, in_r, out_l, out_r, ticks, SPU_GENERIC);
+}
+
+static void spu_process_ticks_ramped(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                                     const float *in_l, const float *in_r,
+                                     float *out_l, float *out_r, int ticks) {
+    spu_run(wa, p, step, in_l, in_r, out_l, out_r, ticks, SPU_GENERIC);
+}
+
+/* One specialized static kernel per built-in preset */
+#define SPU_PRESET_KERNEL(idx) \
+    static void spu_process_ticks_p##idx(workarea_t *wa, scaled_preset_t *p,          \
+                                         const float *in_l, const float *in_r,         \
+                                         float *out_l, float *out_r, int ticks) {      \
+        spu_process_ticks_preset(wa, p, in_l, in_r, out_l, out_r, ticks, idx);         \
+    }
+SPU_PRESET_KERNEL(0)
+SPU_PRESET_KERNEL(1)
+SPU_PRESET_KERNEL(2)
+SPU_PRESET_KERNEL(3)
+SPU_PRESET_KERNEL(4)
+SPU_PRESET_KERNEL(5)
+#undef SPU_PRESET_KERNEL
+
+/* Pass 3 while frozen: replay the work area instead of feeding it. Input and
+ * the reflection stage are skipped and nothing is written, so the combs and
+ * all-passes read a history that repeats once per work area cycle; dir -1
+ * walks it backwards. Engine-agnostic, since it only reads int16 samples.
+ * Volumes ramp as in spu_run. */
+static inline __attribute__((always_inline))
+void spu_run_frozen(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                    float *out_l, float *out_r, int ticks, int dir) {
+    const int16_t *buf = wa->buf;
+    const uint32_t *off = p->taps.off;
+    const uint32_t mask = wa->size_mask;
+    const float vCOMB1 = p->vCOMB1_f, vCOMB2 = p->vCOMB2_f;
+    const float vCOMB3 = p->vCOMB3_f, vCOMB4 = p->vCOMB4_f;
+    const float vAPF1 = p->vAPF1_f, vAPF2 = p->vAPF2_f;
+    float vLOUT = p->vLOUT_f, vROUT = p->vROUT_f;
+    uint32_t base = wa->base;
+#define RD(tap) ((float)buf[(base + off[tap]) & mask] * kInt16ToFloat)
+
+    for (int t = 0; t < ticks; t++) {
+        float Lout = vCOMB1 * RD(TAP_COMB + 0) + vCOMB2 * RD(TAP_COMB + 2) +
+                     vCOMB3 * RD(TAP_COMB + 4) + vCOMB4 * RD(TAP_COMB + 6);
+        float Rout = vCOMB1 * RD(TAP_COMB + 1) + vCOMB2 * RD(TAP_COMB + 3) +
+                     vCOMB3 * RD(TAP_COMB + 5) + vCOMB4 * RD(TAP_COMB + 7);
+
+        float del = RD(TAP_APF_DEL + 0);
+        Lout = (Lout - vAPF1 * del) * vAPF1 + del;
+        del = RD(TAP_APF_DEL + 1);
+        Rout = (Rout - vAPF1 * del) * vAPF1 + del;
+        del = RD(TAP_APF_DEL + 2);
+        Lout = (Lout - vAPF2 * del) * vAPF2 + del;
+        del = RD(TAP_APF_DEL + 3);
+        Rout = (Rout - vAPF2 * del) * vAPF2 + del;
+
+        out_l[t] = Lout * vLOUT;
+        out_r[t] = Rout * vROUT;
+
+        if (step) {
+            vLOUT += step->vLOUT;
+            vROUT += step->vROUT;
+        }
+        base = (base + (uint32_t)dir) & mask;
+    }
+#undef RD
+    wa->base = base;
+
+    if (step) {
+        /* The unused volumes still have to land on their targets */
+        p->vWALL_f += step->vWALL * (float)ticks;
+        p->vLIN_f += step->vLIN * (float)ticks;
+        p->vRIN_f += step->vRIN * (float)ticks;
+        p->vLOUT_f = vLOUT;
+        p->vROUT_f = vROUT;
+    }
+}
+
+#define SPU_FROZEN_KERNEL(name, dir) \
+    static void spu_process_##name(workarea_t *wa, scaled_preset_t *p,                     \
+                                   const float *in_l, const float *in_r,                    \
+                                   float *out_l, float *out_r, int ticks) {                 \
+        (void)in_l; (void)in_r;                                                             \
+        spu_run_frozen(wa, p, NULL, out_l, out_r, ticks, dir);                              \
+    }                                                                                       \
+    static void spu_process_##name##_ramped(workarea_t *wa, scaled_preset_t *p,            \
+                                            const spu_volumes_t *step,                      \
+                                            const float *in_l, const float *in_r,           \
+                                            float *out_l, float *out_r, int ticks) {        \
+        (void)in_l; (void)in_r;                                                             \
+        spu_run_frozen(wa, p, step, out_l, out_r, ticks, dir);                              \
+    }
+SPU_FROZEN_KERNEL(loop, 1)
+SPU_FROZEN_KERNEL(reverse, -1)
+#undef SPU_FROZEN_KERNEL
+
+/* ============================================================================
+ * FIXED-POINT SPU CORE
+ * Q15 engine in the style of the real SPU: work area samples stay int16,
+ * every volume multiply is (a * v) >> 15 and every sum saturates to int16.
+ * Float only appears at the edges (input and output volume, which exceed
+ * the Q15 range at high input_gain / reverb_level).
+ *
+ * Lanes: the four reflections run as one 4-lane op {LSAME, RSAME, LDIFF,
+ * RDIFF}; comb taps as {1L, 1R, 2L, 2R} + {3L, 3R, 4L, 4R}; APFs as {L, R}.
+ * Each stage reads all its taps before writing. No preset has a stage read
+ * that aliases a write from the same stage, except Room's unused DIFF taps
+ * (all at address 0, feeding only the 0-volume combs 3/4).
+ * The NEON path uses vqdmulh/vqadd; the scalar path matches it bit for bit.
+ * ============================================================================ */
+
+static inline int16_t q15_sat(int32_t v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+/* float in [-1, 1) -> Q15, truncating like workarea_write_relative */
+static inline int16_t q15_from_float(float v) {
+    float x = v * kFloatToInt16;
+    if (x >= 32767.0f) return 32767;
+    if (x <= -32768.0f) return -32768;
+    return (int16_t)x;
+}
+
+#if PSXVERB_USE_NEON
+typedef int16x4_t q15x4_t;
+#define q15x4_load(p) vld1_s16(p)
+#define q15x4_store(p, v) vst1_s16((p), (v))
+#define q15x4_mul(a, b) vqdmulh_s16((a), (b))
+#define q15x4_add(a, b) vqadd_s16((a), (b))
+#define q15x4_sub(a, b) vqsub_s16((a), (b))
+/* {a0 + a2, a1 + a3, ...}: fold the high pair onto the low pair */
+#define q15x4_fold(a) vqadd_s16((a), vext_s16((a), (a), 2))
+#else
+typedef struct { int16_t v[4]; } q15x4_t;
+
+static inline q15x4_t q15x4_load(const int16_t *p) {
+    q15x4_t r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+static inline void q15x4_store(int16_t *p, q15x4_t a) {
+    p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3];
+}
+static inline q15x4_t q15x4_mul(q15x4_t a, q15x4_t b) {
+    q15x4_t r;
+    for (int i = 0; i < 4; i++) r.v[i] = q15_sat(((int32_t)a.v[i] * b.v[i]) >> 15);
+    return r;
+}
+static inline q15x4_t q15x4_add(q15x4_t a, q15x4_t b) {
+    q15x4_t r;
+    for (int i = 0; i < 4; i++) r.v[i] = q15_sat((int32_t)a.v[i] + b.v[i]);
+    return r;
+}
+static inline q15x4_t q15x4_sub(q15x4_t a, q15x4_t b) {
+    q15x4_t r;
+    for (int i = 0; i < 4; i++) r.v[i] = q15_sat((int32_t)a.v[i] - b.v[i]);
+    return r;
+}
+static inline q15x4_t q15x4_fold(q15x4_t a) {
+    q15x4_t r = {{q15_sat((int32_t)a.v[0] + a.v[2]), q15_sat((int32_t)a.v[1] + a.v[3]),
+                  q15_sat((int32_t)a.v[2] + a.v[0]), q15_sat((int32_t)a.v[3] + a.v[1])}};
+    return r;
+}
+#endif
+
+static inline __attribute__((always_inline))
+void spu_run_q15(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                 const float *in_l, const float *in_r,
+                 float *out_l, float *out_r, int ticks) {
+    float vWALL_f = p->vWALL_f;
+    float vLIN = p->vLIN_f, vRIN = p->vRIN_f;
+    float vLOUT = p->vLOUT_f, vROUT = p->vROUT_f;
+
+    const int16_t iir = q15_from_float(p->vIIR_f);
+    const int16_t c1 = q15_from_float(p->vCOMB1_f), c2 = q15_from_float(p->vCOMB2_f);
+    const int16_t c3 = q15_from_float(p->vCOMB3_f), c4 = q15_from_float(p->vCOMB4_f);
+    const int16_t a1 = q15_from_float(p->vAPF1_f), a2 = q15_from_float(p->vAPF2_f);
+    const int16_t k_iir[4] = {iir, iir, iir, iir};
+    const int16_t k_c12[4] = {c1, c1, c2, c2};
+    const int16_t k_c34[4] = {c3, c3, c4, c4};
+    const int16_t k_a1[4] = {a1, a1, 0, 0};
+    const int16_t k_a2[4] = {a2, a2, 0, 0};
+    const q15x4_t v_iir = q15x4_load(k_iir);
+    const q15x4_t v_c12 = q15x4_load(k_c12), v_c34 = q15x4_load(k_c34);
+    const q15x4_t v_a1 = q15x4_load(k_a1), v_a2 = q15x4_load(k_a2);
+
+    int16_t wall = q15_from_float(vWALL_f);
+    int16_t k_wall[4] = {wall, wall, wall, wall};
+    q15x4_t v_wall = q15x4_load(k_wall);
+
+    const int16_t *mem = wa->buf;
+    uint32_t ix[TAP_COUNT];
+    for (int i = 0; i < TAP_COUNT; i++) ix[i] = (wa->base + p->taps.off[i]) & wa->size_mask;
+#define RD(tap) mem[ix[tap] + t]
+#define WR(tap, v) workarea_write_q15_at(wa, ix[tap] + t, (v))
+
+    for (int t = 0; t < ticks; t++) {
+        int16_t lin = q15_from_float(in_l[t] * vLIN);
+        int16_t rin = q15_from_float(in_r[t] * vRIN);
+        int16_t buf[4];
+
+        /* Same/Diff reflections: {LSAME, RSAME, LDIFF, RDIFF} */
+        const int16_t k_in[4] = {lin, rin, lin, rin};
+        const int16_t k_fb[4] = {
+            RD(TAP_FB + 0), RD(TAP_FB + 1), RD(TAP_FB + 2), RD(TAP_FB + 3)};
+        const int16_t k_hist[4] = {
+            RD(TAP_HIST + 0), RD(TAP_HIST + 1), RD(TAP_HIST + 2), RD(TAP_HIST + 3)};
+        q15x4_t hist = q15x4_load(k_hist);
+        q15x4_t refl = q15x4_add(q15x4_load(k_in), q15x4_mul(q15x4_load(k_fb), v_wall));
+        refl = q15x4_add(q15x4_mul(q15x4_sub(refl, hist), v_iir), hist);
+        q15x4_store(buf, refl);
+        WR(TAP_REFL + 0, buf[0]);
+        WR(TAP_REFL + 1, buf[1]);
+        WR(TAP_REFL + 2, buf[2]);
+        WR(TAP_REFL + 3, buf[3]);
+
+        /* Comb filter bank: (1 + 3) + (2 + 4) per channel */
+        const int16_t k_comb12[4] = {
+            RD(TAP_COMB + 0), RD(TAP_COMB + 1), RD(TAP_COMB + 2), RD(TAP_COMB + 3)};
+        const int16_t k_comb34[4] = {
+            RD(TAP_COMB + 4), RD(TAP_COMB + 5), RD(TAP_COMB + 6), RD(TAP_COMB + 7)};
+        q15x4_t out = q15x4_fold(q15x4_add(q15x4_mul(q15x4_load(k_comb12), v_c12),
+                                           q15x4_mul(q15x4_load(k_comb34), v_c34)));
+
+        /* All-pass filter 1: {L, R, -, -} */
+        const int16_t k_d1[4] = {RD(TAP_APF_DEL + 0), RD(TAP_APF_DEL + 1), 0, 0};
+        q15x4_t del = q15x4_load(k_d1);
+        out = q15x4_sub(out, q15x4_mul(del, v_a1));
+        q15x4_store(buf, out);
+        WR(TAP_APF + 0, buf[0]);
+        WR(TAP_APF + 1, buf[1]);
+        out = q15x4_add(q15x4_mul(out, v_a1), del);
+
+        /* All-pass filter 2 */
+        const int16_t k_d2[4] = {RD(TAP_APF_DEL + 2), RD(TAP_APF_DEL + 3), 0, 0};
+        del = q15x4_load(k_d2);
+        out = q15x4_sub(out, q15x4_mul(del, v_a2));
+        q15x4_store(buf, out);
+        WR(TAP_APF + 2, buf[0]);
+        WR(TAP_APF + 3, buf[1]);
+        out = q15x4_add(q15x4_mul(out, v_a2), del);
+        q15x4_store(buf, out);
+
+        out_l[t] = (float)buf[0] * kInt16ToFloat * vLOUT;
+        out_r[t] = (float)buf[1] * kInt16ToFloat * vROUT;
+
+        if (step) {
+            vWALL_f += step->vWALL;
+            vLIN += step->vLIN;
+            vRIN += step->vRIN;
+            vLOUT += step->vLOUT;
+            vROUT += step->vROUT;
+            wall = q15_from_float(vWALL_f);
+            k_wall[0] = k_wall[1] = k_wall[2] = k_wall[3] = wall;
+            v_wall = q15x4_load(k_wall);
+        }
+    }
+#undef RD
+#undef WR
+    workarea_advance(wa, (uint32_t)ticks);
+
+    if (step) {
+        p->vWALL_f = vWALL_f;
+        p->vLIN_f = vLIN;
+        p->vRIN_f = vRIN;
+        p->vLOUT_f = vLOUT;
+        p->vROUT_f = vROUT;
+    }
+}
+
+static void spu_process_ticks_q15(workarea_t *wa, scaled_preset_t *p,
+                                  const float *in_l, const float *in_r,
+                                  float *out_l, float *out_r, int ticks) {
+    spu_run_q15(wa, p, NULL, in_l, in_r, out_l, out_r, ticks);
+}
+
+static void spu_process_ticks_q15_ramped(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                                         const float *in_l, const float *in_r,
+                                         float *out_l, float *out_r, int ticks) {
+    spu_run_q15(wa, p, step, in_l, in_r, out_l, out_r, ticks);
+}
+
+/* ============================================================================
+ * ENGINE DISPATCH
+ * One static and one ramped kernel per engine, picked once per call.
+ * ============================================================================ */
+
+enum {
+    ENGINE_FLOAT = 0,   /* Float reference port */
+    ENGINE_FIXED,       /* Q15 saturating integer engine */
+    ENGINE_COUNT
+};
+
+static const char *const g_engine_names[ENGINE_COUNT] = { "Float", "Fixed" };
+
+static const spu_kernel_fn g_spu_kernels[ENGINE_COUNT] = {
+    spu_process_ticks, spu_process_ticks_q15
+};
+static const spu_ramp_kernel_fn g_spu_ramp_kernels[ENGINE_COUNT] = {
+    spu_process_ticks_ramped, spu_process_ticks_q15_ramped
+};
+
+/* Float kernels specialized per built-in preset. Build with
+ * -DPSXVERB_NO_PRESET_KERNELS to run every preset on the generic one. */
+#ifdef PSXVERB_NO_PRESET_KERNELS
+#define PSXVERB_PRESET_KERNELS 0
+#else
+#define PSXVERB_PRESET_KERNELS 1
+#endif
+
+static const spu_kernel_fn g_spu_preset_kernels[PRESET_COUNT] = {
+    spu_process_ticks_p0, spu_process_ticks_p1, spu_process_ticks_p2,
+    spu_process_ticks_p3, spu_process_ticks_p4, spu_process_ticks_p5
+};
+
+/* Static kernel for preset idx on the live engine; bank presets always run
+ * the generic one. A specialization that
+ * drops the DIFF reflection is only exact when this rate's taps allow it,
+ * so those fall back to the generic kernel otherwise. */
+static spu_kernel_fn v2_pick_kernel(const psxverb_instance_t *inst, int idx) {
+    if (!PSXVERB_PRESET_KERNELS || inst->live.engine != ENGINE_FLOAT || idx >= PRESET_COUNT) {
+        return g_spu_kernels[inst->live.engine];
+    }
+    if (!SPU_HAS_DIFF(idx) && !inst->rates->presets[idx].taps.diff_dead) {
+        return g_spu_kernels[ENGINE_FLOAT];
+    }
+    return g_spu_preset_kernels[idx];
+}
+
+static const spu_kernel_fn g_spu_frozen_kernels[FREEZE_COUNT] = {
+    NULL, spu_process_loop, spu_process_reverse
+};
+static const spu_ramp_kernel_fn g_spu_frozen_ramp_kernels[FREEZE_COUNT] = {
+    NULL, spu_process_loop_ramped, spu_process_reverse_ramped
+};
+
+/* Audio side: refresh the kernel pointers after the engine, preset or
+ * freeze mode moved. Frozen, both cores replay on the same kernel. */
+static void v2_select_kernels(psxverb_instance_t *inst) {
+    int fz = inst->live.freeze;
+    if (fz != FREEZE_OFF) {
+        inst->kernel = inst->fade_kernel = g_spu_frozen_kernels[fz];
+        inst->ramp_kernel = g_spu_frozen_ramp_kernels[fz];
+        return;
+    }
+    inst->kernel = v2_pick_kernel(inst, inst->active_preset);
+    inst->fade_kernel = v2_pick_kernel(inst, inst->fade_index);
+    inst->ramp_kernel = g_spu_ramp_kernels[inst->live.engine];
+}
+
+/* Pass 3b: linear crossfade from the outgoing core to the active one.
+ * Counts *remaining down; ticks past the end take the active core only. */
+static void block_crossfade(float *l, float *r, const float *old_l, const float *old_r,
+                            uint32_t *remaining, uint32_t length, int ticks) {
+    float step = 1.0f / (float)length;
+    float g_old = (float)*remaining * step;
+    for (int t = 0; t < ticks; t++) {
+        l[t] += (old_l[t] - l[t]) * g_old;
+        r[t] += (old_r[t] - r[t]) * g_old;
+        g_old = max_f(g_old - step, 0.0f);
+    }
+    *remaining = (*remaining > (uint32_t)ticks) ? *remaining - (uint32_t)ticks : 0;
+}
+
+/* ============================================================================
+ * RESAMPLERS
+ * `resampler` selects the 2:1 / 1:2 filter pair around the SPU core:
+ * - 39-tap: the exact Halfband39 reference
+ * - 11-tap: short unity-gain halfband (3 pairs instead of 10)
+ * - 2-tap: pair averaging down, linear interpolation up
+ * - IIR: polyphase allpass halfband, minimum phase, for live monitoring
+ * Each is its own set of block kernels with the coefficients inlined as
+ * constants, dispatched once per block like the engines; the loops never
+ * branch on the mode. The short filters are conventional lowpasses while
+ * the reference kernel is not (its even taps share one sign: -4.7 dB at DC
+ * rising to +5 dB at Nyquist), so tone and level differ between modes.
+ * Mono routing sums L+R into one decimator that feeds both SPU inputs.
+ * ============================================================================ */
+
+enum {
+    RESAMPLER_HB39 = 0,
+    RESAMPLER_HB11,
+    RESAMPLER_LINEAR,
+    RESAMPLER_IIR,
+    RESAMPLER_COUNT
+};
+
+static const char *const g_resampler_names[RESAMPLER_COUNT] = {"39-tap", "11-tap", "2-tap", "IIR"};
+
+#define HB39_ARGS g_hb_pair_coeffs, HB_PAIRS, g_hb_center, HB_CENTER_DELAY
+#define HB11_ARGS g_hb11_pair_coeffs, HB11_PAIRS, g_hb11_center, HB11_CENTER_DELAY
+
+static void block_decimate_hb39(hb_decimator_t *d, const float *l, const float *r,
+                                float *tick_l, float *tick_r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        halfband_decimate(d, HB39_ARGS, l[t * 2], r[t * 2], l[t * 2 + 1], r[t * 2 + 1],
+                          &tick_l[t], &tick_r[t]);
+    }
+}
+
+static void block_decimate_hb11(hb_decimator_t *d, const float *l, const float *r,
+                                float *tick_l, float *tick_r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        halfband_decimate(d, HB11_ARGS, l[t * 2], r[t * 2], l[t * 2 + 1], r[t * 2 + 1],
+                          &tick_l[t], &tick_r[t]);
+    }
+}
+
+static void block_decimate_linear(hb_decimator_t *d, const float *l, const float *r,
+                                  float *tick_l, float *tick_r, int ticks) {
+    (void)d;
+    for (int t = 0; t < ticks; t++) {
+        tick_l[t] = (l[t * 2] + l[t * 2 + 1]) * 0.5f;
+        tick_r[t] = (r[t * 2] + r[t * 2 + 1]) * 0.5f;
+    }
+}
+
+static void block_decimate_iir(hb_decimator_t *d, const float *l, const float *r,
+                               float *tick_l, float *tick_r, int ticks) {
+    iir_hb_t iir = d->iir;  /* Local copy stays in registers */
+    for (int t = 0; t < ticks; t++) {
+        iir_halfband_decimate(&iir, l[t * 2], r[t * 2], l[t * 2 + 1], r[t * 2 + 1],
+                              &tick_l[t], &tick_r[t]);
+    }
+    d->iir = iir;
+}
+
+static void block_decimate_mono_hb39(hb_mono_decimator_t *d, const float *l, const float *r,
+                                     float *tick_l, float *tick_r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        float x0 = (l[t * 2] + r[t * 2]) * 0.5f;
+        float x1 = (l[t * 2 + 1] + r[t * 2 + 1]) * 0.5f;
+        tick_l[t] = tick_r[t] = halfband_decimate_mono(d, HB39_ARGS, x0, x1);
+    }
+}
+
+static void block_decimate_mono_hb11(hb_mono_decimator_t *d, const float *l, const float *r,
+                                     float *tick_l, float *tick_r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        float x0 = (l[t * 2] + r[t * 2]) * 0.5f;
+        float x1 = (l[t * 2 + 1] + r[t * 2 + 1]) * 0.5f;
+        tick_l[t] = tick_r[t] = halfband_decimate_mono(d, HB11_ARGS, x0, x1);
+    }
+}
+
+static void block_decimate_mono_linear(hb_mono_decimator_t *d, const float *l, const float *r,
+                                       float *tick_l, float *tick_r, int ticks) {
+    (void)d;
+    for (int t = 0; t < ticks; t++) {
+        float x0 = (l[t * 2] + r[t * 2]) * 0.5f;
+        float x1 = (l[t * 2 + 1] + r[t * 2 + 1]) * 0.5f;
+        tick_l[t] = tick_r[t] = (x0 + x1) * 0.5f;
+    }
+}
+
+static void block_decimate_mono_iir(hb_mono_decimator_t *d, const float *l, const float *r,
+                                    float *tick_l, float *tick_r, int ticks) {
+    iir_hb_t iir = d->iir;  /* Local copy stays in registers */
+    for (int t = 0; t < ticks; t++) {
+        float x0 = (l[t * 2] + r[t * 2]) * 0.5f;
+        float x1 = (l[t * 2 + 1] + r[t * 2 + 1]) * 0.5f;
+        tick_l[t] = tick_r[t] = iir_halfband_decimate_mono(&iir, x0, x1);
+    }
+    d->iir = iir;
+}
+
+static void block_interpolate_hb39(hb_interpolator_t *u, const float *tick_l, const float *tick_r,
+                                   float *l, float *r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        halfband_interpolate(u, HB39_ARGS, tick_l[t], tick_r[t],
+                             &l[t * 2], &r[t * 2], &l[t * 2 + 1], &r[t * 2 + 1]);
+    }
+}
+
+static void block_interpolate_hb11(hb_interpolator_t *u, const float *tick_l, const float *tick_r,
+                                   float *l, float *r, int ticks) {
+    for (int t = 0; t < ticks; t++) {
+        halfband_interpolate(u, HB11_ARGS, tick_l[t], tick_r[t],
+                             &l[t * 2], &r[t * 2], &l[t * 2 + 1], &r[t * 2 + 1]);
+    }
+}
+
+/* Midpoint of the previous and current tick, then the current tick */
+static void block_interpolate_linear(hb_interpolator_t *u, const float *tick_l, const float *tick_r,
+                                     float *l, float *r, int ticks) {
+    const float *prev = hb_ring_tap(&u->hist, 0);
+    float pl = prev[0], pr = prev[1];
+    for (int t = 0; t < ticks; t++) {
+        l[t * 2] = (pl + tick_l[t]) * 0.5f;
+        r[t * 2] = (pr + tick_r[t]) * 0.5f;
+        l[t * 2 + 1] = pl = tick_l[t];
+        r[t * 2 + 1] = pr = tick_r[t];
+    }
+    if (ticks > 0) hb_ring_push(&u->hist, pl, pr);
+}
+
+static void block_interpolate_iir(hb_interpolator_t *u, const float *tick_l, const float *tick_r,
+                                  float *l, float *r, int ticks) {
+    iir_hb_t iir = u->iir;  /* Local copy stays in registers */
+    for (int t = 0; t < ticks; t++) {
+        iir_halfband_interpolate(&iir, tick_l[t], tick_r[t],
+                                 &l[t * 2], &r[t * 2], &l[t * 2 + 1], &r[t * 2 + 1]);
+    }
+    u->iir = iir;
+}
+
+typedef void (*decimate_fn)(hb_decimator_t *d, const float *l, const float *r,
+                            float *tick_l, float *tick_r, int ticks);
+typedef void (*decimate_mono_fn)(hb_mono_decimator_t *d, const float *l, const float *r,
+                                 float *tick_l, float *tick_r, int ticks);
+typedef void (*interpolate_fn)(hb_interpolator_t *u, const float *tick_l, const float *tick_r,
+                               float *l, float *r, int ticks);
+
+typedef struct {
+    decimate_fn decimate;
+    decimate_mono_fn decimate_mono;
+    interpolate_fn interpolate;
+} resampler_kernels_t;
+
+static const resampler_kernels_t g_resamplers[RESAMPLER_COUNT] = {
+    {block_decimate_hb39, block_decimate_mono_hb39, block_interpolate_hb39},
+    {block_decimate_hb11, block_decimate_mono_hb11, block_interpolate_hb11},
+    {block_decimate_linear, block_decimate_mono_linear, block_interpolate_linear},
+    {block_decimate_iir, block_decimate_mono_iir, block_interpolate_iir},
+};
+
+/* Round-trip delay of the wet path in host-rate frames (decimator plus
+ * interpolator), for get_param("latency_samples"). The FIR modes are linear
+ * phase and exact at every frequency (the polyphase split saves one frame
+ * over 2 x half the length; 2-tap is 0 or 1 depending on the input phase,
+ * reported as 1). For IIR it is the DC group delay, 4.3 frames, rising by
+ * about a frame towards the top of the band. */
+static const int g_resampler_latency[RESAMPLER_COUNT] = {37, 9, 1, 4};
+
+/* ============================================================================
+ * OUTPUT KERNELS
+ * Pass 5 (dry/wet mix) is chosen once per chunk from the live mix:
+ * - Dry: mix == 0, the input is already in place so nothing is written and
+ *   the interpolation pass is skipped too (the SPU keeps running so the tail
+ *   is intact when the mix comes back up)
+ * - Wet: mix == 1, the dry signal is never read back
+ * - Blend: everything else
+ * The ramped kernel below covers frames inside a parameter ramp.
+ * The Wet and Mono routings always take the wet kernel and ignore mix.
+ * Kernels write planar float: into planar float host buffers directly,
+ * otherwise into the wet scratch, which io_store then converts.
+ * ============================================================================ */
+
+enum {
+    ROUTING_INSERT = 0, /* Dry/wet blend set by mix */
+    ROUTING_WET,        /* Wet only, for send/return buses */
+    ROUTING_MONO,       /* Wet only, L+R summed into a single decimator */
+    ROUTING_COUNT
+};
+
+static const char *const g_routing_names[ROUTING_COUNT] = { "Insert", "Wet", "Mono" };
+
+enum { MIX_DRY, MIX_WET, MIX_BLEND, MIX_MODE_COUNT };
+
+typedef void (*mix_kernel_fn)(const float *dry_l, const float *dry_r,
+                              const float *wet_l, const float *wet_r, float mix,
+                              float *out_l, float *out_r, int frames);
+
+static void block_mix_wet(const float *dry_l, const float *dry_r,
+                          const float *wet_l, const float *wet_r, float mix,
+                          float *out_l, float *out_r, int frames) {
+    (void)dry_l; (void)dry_r; (void)mix;
+    if (out_l == wet_l) return;
+    memcpy(out_l, wet_l, (size_t)frames * sizeof(float));
+    memcpy(out_r, wet_r, (size_t)frames * sizeof(float));
+}
+
+/* out may alias the dry or the wet buffers */
+static void block_mix_blend(const float *dry_l, const float *dry_r,
+                            const float *wet_l, const float *wet_r, float mix,
+                            float *out_l, float *out_r, int frames) {
+    float dry_mix = 1.0f - mix;
+    float wet_mix = mix;
+    for (int i = 0; i < frames; i++) {
+        out_l[i] = dry_l[i] * dry_mix + wet_l[i] * wet_mix;
+        out_r[i] = dry_r[i] * dry_mix + wet_r[i] * wet_mix;
+    }
+}
+
+/* No MIX_DRY kernel: the host buffer already holds the dry input and the
+ * callers skip the store */
+static const mix_kernel_fn g_mix_kernels[MIX_MODE_COUNT] = {
+    [MIX_WET] = block_mix_wet, [MIX_BLEND] = block_mix_blend
+};
+
+static int mix_mode(float mix) {
+    if (mix <= 0.0f) return MIX_DRY;
+    if (mix >= 1.0f) return MIX_WET;
+    return MIX_BLEND;
+}
+
+/* Pass 5, ramped: mix advances by step every frame, returns the final mix */
+static float block_mix_ramp(const float *dry_l, const float *dry_r,
+                            const float *wet_l, const float *wet_r, float mix, float step,
+                            float *out_l, float *out_r, int frames) {
+    for (int i = 0; i < frames; i++) {
+        out_l[i] = dry_l[i] * (1.0f - mix) + wet_l[i] * mix;
+        out_r[i] = dry_r[i] * (1.0f - mix) + wet_r[i] * mix;
+        mix += step;
+    }
+    return mix;
+}
+
+/* ============================================================================
+ * PARAMETER SMOOTHING
+ * set_param latches targets and marks them dirty; at the next block the live
+ * values start a linear ramp of SMOOTH_TICKS ticks towards them. A static
+ * patch never enters the ramped kernels.
+ * ============================================================================ */
+
+#define SMOOTH_TICKS 256   /* ~10 ms at the SPU tick rate */
+
+/* Start a ramp from the live values to the latched targets */
+static void v2_begin_ramp(psxverb_instance_t *inst) {
+    const float k = 1.0f / (float)SMOOTH_TICKS;
+    const scaled_preset_t *c = &inst->current;
+    inst->ramp_step.vWALL = (inst->target.vWALL - c->vWALL_f) * k;
+    inst->ramp_step.vLIN = (inst->target.vLIN - c->vLIN_f) * k;
+    inst->ramp_step.vRIN = (inst->target.vRIN - c->vRIN_f) * k;
+    inst->ramp_step.vLOUT = (inst->target.vLOUT - c->vLOUT_f) * k;
+    inst->ramp_step.vROUT = (inst->target.vROUT - c->vROUT_f) * k;
+    inst->mix_step = (inst->live.mix - inst->mix_cur) * (0.5f * k);
+    inst->ramp_remaining = SMOOTH_TICKS;
+}
+
+/* Ramp ticks to run in a chunk of `ticks`; the rest of the chunk is static */
+static int v2_ramp_ticks(psxverb_instance_t *inst, int ticks) {
+    if (inst->ramp_remaining == 0) return 0;
+    int n = (inst->ramp_remaining < (uint32_t)ticks) ? (int)inst->ramp_remaining : ticks;
+    inst->ramp_remaining -= (uint32_t)n;
+    return n;
+}
+
+/* ============================================================================
+ * SILENCE BYPASS
+ * Once the input has been digital silence and the wet output has stayed
+ * below one LSB for a full work area cycle, the work area itself is scanned
+ * (SILENCE_SCAN samples per block) so a tail that vLOUT merely hides, e.g.
+ * at reverb_level 0, is not frozen. Only when a whole pass finds nothing
+ * above SILENCE_WORK_PEAK does the instance sleep: silent blocks return
+ * untouched (silence in, silence out) without running the resamplers or
+ * the SPU core. The first non-zero sample wakes it within the same block.
+ * ============================================================================ */
+
+#define SILENCE_WET_PEAK (1.0f / 32768.0f)  /* Below one output LSB */
+#define SILENCE_WORK_PEAK 1                 /* Work area LSB left by rounding */
+#define SILENCE_SCAN 1024                   /* Work area samples checked per block */
+
+/* Peak absolute value of a planar stereo float buffer */
+static float block_peak_f(const float *l, const float *r, int n) {
+    float peak = 0.0f;
+    for (int i = 0; i < n; i++) {
+        peak = max_f(peak, abs_f(l[i]));
+        peak = max_f(peak, abs_f(r[i]));
+    }
+    return peak;
+}
+
+/* Asleep: keep parameter and preset state current without processing.
+ * Ramps and crossfades are skipped since there is nothing audible to shape. */
+static void v2_idle_block(psxverb_instance_t *inst) {
+    inst->fade_remaining = 0;
+    if (inst->params_dirty) {
+        inst->params_dirty = 0;
+        v2_snap_volumes(inst);
+    }
+    inst->ramp_remaining = 0;
+    inst->mix_cur = inst->live.mix;
+}
+
+/* Track silence after a processed block and fall asleep once the tail is gone */
+static void v2_track_silence(psxverb_instance_t *inst, int in_active, float wet_peak, int ticks) {
+    if (in_active || wet_peak >= SILENCE_WET_PEAK ||
+        inst->ramp_remaining > 0 || inst->fade_remaining > 0) {
+        inst->quiet_ticks = 0;
+        return;
+    }
+    const workarea_t *wa = &inst->core[inst->active].work;
+    inst->quiet_ticks += (uint32_t)ticks;
+    if (inst->quiet_ticks <= wa->size_mask) {
+        inst->quiet_scan = 0;
+        return;
+    }
+
+    /* The output is quiet; check the tail behind vLOUT is gone too */
+    uint32_t total = (wa->size_mask + 1) * inst->lanes;
+    uint32_t n = total - inst->quiet_scan < SILENCE_SCAN ? total - inst->quiet_scan : SILENCE_SCAN;
+    const int16_t *p = wa->buf + inst->quiet_scan;
+    int peak = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        int x = abs(p[i]);
+        peak = x > peak ? x : peak;
+    }
+    inst->quiet_scan = peak > SILENCE_WORK_PEAK ? 0 : inst->quiet_scan + n;
+    if (inst->quiet_scan == total) {
+        /* Residue is below one LSB; start the next wake from clean filters */
+        v2_reset_filters(inst, 1);
+        inst->sleeping = 1;
+    }
+}
+
+/* ============================================================================
+ * DENORMAL GUARD
+ * Long tails decay towards zero, and float state passing through the
+ * subnormal range takes the slow path on most cores. Two layers:
+ * - process_block runs with flush-to-zero set (FPCR.FZ on AArch64, MXCSR
+ *   FTZ|DAZ on x86 hosts used for the bench), whatever the host left in
+ *   the control register, and restores it on return
+ * - the only recursive float state, the IIR resampler's allpass memory,
+ *   sees DENORMAL_DC on every input, so a decayed tail settles on that
+ *   offset instead of zero. Its fast sections fall by tens of decades per
+ *   block, so snapping at block boundaries would be too late
+ * The FIR histories hold int16 samples or products of them, so they are
+ * always zero or normal. Chunks that start with allpass memory sitting on
+ * the offset (below DENORMAL_FLOOR) are counted: without it they would have
+ * run through subnormals. See get_param("denormals"). Build with
+ * -DPSXVERB_NO_FTZ to leave the control register alone.
+ * ============================================================================ */
+
+#define DENORMAL_FLOOR 1e-15f  /* 1000x DENORMAL_DC */
+
+#if !defined(PSXVERB_NO_FTZ) && defined(__aarch64__)
+#define PSXVERB_FTZ 1
+#define FPCR_FZ (1ull << 24)
+typedef uint64_t fp_env_t;
+
+static inline fp_env_t fp_env_enter(void) {
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    if (!(fpcr & FPCR_FZ)) __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | FPCR_FZ));
+    return fpcr;
+}
+
+static inline void fp_env_leave(fp_env_t fpcr) {
+    if (!(fpcr & FPCR_FZ)) __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+}
+#elif !defined(PSXVERB_NO_FTZ) && defined(__SSE__)
+#include <xmmintrin.h>
+#define PSXVERB_FTZ 1
+#define MXCSR_FTZ_DAZ 0x8040u
+typedef unsigned int fp_env_t;
+
+static inline fp_env_t fp_env_enter(void) {
+    unsigned int csr = _mm_getcsr();
+    if ((csr & MXCSR_FTZ_DAZ) != MXCSR_FTZ_DAZ) _mm_setcsr(csr | MXCSR_FTZ_DAZ);
+    return csr;
+}
+
+static inline void fp_env_leave(fp_env_t csr) {
+    if ((csr & MXCSR_FTZ_DAZ) != MXCSR_FTZ_DAZ) _mm_setcsr(csr);
+}
+#else
+#define PSXVERB_FTZ 0
+typedef int fp_env_t;
+
+static inline fp_env_t fp_env_enter(void) { return 0; }
+static inline void fp_env_leave(fp_env_t env) { (void)env; }
+#endif
+
+/* Any of the first `lanes` lanes of allpass memory within the floor */
+static int iir_hb_at_floor(const iir_hb_t *s, int lanes) {
+    for (int k = 0; k <= IIR_HB_SECTIONS; ++k) {
+        for (int i = 0; i < lanes; ++i) {
+            if (abs_f(s->mem[k][i]) < DENORMAL_FLOOR) return 1;
+        }
+    }
+    return 0;
+}
+
+static void v2_count_denormals(psxverb_instance_t *inst) {
+    int floor = (inst->live.routing == ROUTING_MONO) ? iir_hb_at_floor(&inst->down_mono.iir, 2)
+                                                     : iir_hb_at_floor(&inst->down.iir, 4);
+    if (!floor && !iir_hb_at_floor(&inst->up.iir, 4)) return;
+    atomic_store_explicit(&inst->denormal_chunks,
+                          atomic_load_explicit(&inst->denormal_chunks, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+/* Run the pipeline over an even number of frames in place */
+static void v2_process_frames(psxverb_instance_t *inst, const block_io_t *io, int frames) {
+    block_scratch_t s;
+    v2_consume_params(inst);
+    v2_update_cores(inst);
+    inst->started = 1;
+
+    int in_active = io_active(io, frames & ~1);
+    if (inst->sleeping) {
+        if (!in_active) {
+            v2_idle_block(inst);
+            return;
+        }
+        inst->sleeping = 0;
+        inst->quiet_ticks = 0;
+    }
+    float wet_peak = 0.0f;
+
+    if (inst->params_dirty) {
+        inst->params_dirty = 0;
+        v2_begin_ramp(inst);
+    }
+    v2_select_kernels(inst);
+    int frozen = inst->live.freeze != FREEZE_OFF;
+    const resampler_kernels_t *rs = &g_resamplers[inst->live.resampler];
+
+    for (int off = 0; off + 1 < frames; ) {
+        int n = frames - off;
+        if (n > BLOCK_FRAMES) n = BLOCK_FRAMES;
+        n &= ~1;
+        int ticks = n / 2;
+        spu_core_t *core = &inst->core[inst->active];
+        const float *dry_l, *dry_r;
+        float *out_l, *out_r;
+
+        if (inst->live.resampler == RESAMPLER_IIR) v2_count_denormals(inst);
+
+        io_load(io, off, n, s.in_l, s.in_r, &dry_l, &dry_r);
+        io_out(io, off, s.wet_l, s.wet_r, &out_l, &out_r);
+        if (frozen) {
+            /* Frozen kernels take no input; the decimator is reset on thaw */
+        } else if (inst->live.routing == ROUTING_MONO) {
+            rs->decimate_mono(&inst->down_mono, dry_l, dry_r, s.tick_l, s.tick_r, ticks);
+        } else {
+            rs->decimate(&inst->down, dry_l, dry_r, s.tick_l, s.tick_r, ticks);
+        }
+        if (inst->fade_remaining > 0) {
+            inst->fade_kernel(&inst->core[inst->active ^ 1].work, &inst->fade_preset,
+                   s.tick_l, s.tick_r, s.fade_l, s.fade_r, ticks);
+        }
+
+        /* Ramp part of the chunk first, static remainder after */
+        int r = v2_ramp_ticks(inst, ticks);
+        if (r > 0) {
+            inst->ramp_kernel(&core->work, &inst->current, &inst->ramp_step,
+                        s.tick_l, s.tick_r, s.tick_l, s.tick_r, r);
+            if (inst->ramp_remaining == 0) v2_snap_volumes(inst);
+        }
+        if (r < ticks) {
+            inst->kernel(&core->work, &inst->current,
+                         s.tick_l + r, s.tick_r + r, s.tick_l + r, s.tick_r + r, ticks - r);
+        }
+
+        if (inst->fade_remaining > 0) {
+            block_crossfade(s.tick_l, s.tick_r, s.fade_l, s.fade_r,
+                            &inst->fade_remaining, inst->fade_ticks, ticks);
+        }
+        wet_peak = max_f(wet_peak, block_peak_f(s.tick_l, s.tick_r, ticks));
+
+        int rf = r * 2;
+        if (inst->live.routing != ROUTING_INSERT) {
+            /* Send/return: wet only. mix is not applied but keeps tracking
+             * its ramp so switching back to Insert picks up the right value */
+            rs->interpolate(&inst->up, s.tick_l, s.tick_r, s.wet_l, s.wet_r, ticks);
+            block_mix_wet(dry_l, dry_r, s.wet_l, s.wet_r, 1.0f, out_l, out_r, n);
+            io_store(io, off, out_l, out_r, n);
+            inst->mix_cur = (inst->ramp_remaining == 0) ? inst->live.mix
+                                                        : inst->mix_cur + inst->mix_step * (float)rf;
+            off += n;
+            continue;
+        }
+
+        /* Fully dry outside a ramp: the wet signal is not needed at all */
+        int mode = (r > 0) ? MIX_BLEND : mix_mode(inst->mix_cur);
+        if (mode == MIX_DRY) {
+            off += n;
+            continue;
+        }
+        rs->interpolate(&inst->up, s.tick_l, s.tick_r, s.wet_l, s.wet_r, ticks);
+
+        if (rf > 0) {
+            inst->mix_cur = block_mix_ramp(dry_l, dry_r, s.wet_l, s.wet_r,
+                                           inst->mix_cur, inst->mix_step, out_l, out_r, rf);
+            io_store(io, off, out_l, out_r, rf);
+            if (inst->ramp_remaining == 0) inst->mix_cur = inst->live.mix;
+        }
+        mode = mix_mode(inst->mix_cur);
+        if (rf < n && mode != MIX_DRY) {
+            g_mix_kernels[mode](dry_l + rf, dry_r + rf, s.wet_l + rf, s.wet_r + rf,
+                                inst->mix_cur, out_l + rf, out_r + rf, n - rf);
+            io_store(io, off + rf, out_l + rf, out_r + rf, n - rf);
+        }
+
+        off += n;
+    }
+
+    v2_track_silence(inst, in_active, wet_peak, frames / 2);
+}
+
+/* ============================================================================
+ * MULTI-BUS
+ * An instance created with config_json {"buses": K} (2..PSXVERB_MAX_BUSES)
+ * runs K stereo buses with identical settings: one parameter set, one
+ * scaled preset and tap program, one preset switch and crossfade. The K SPU
+ * cores share each work area in structure-of-arrays layout, sample n of bus
+ * b at buf[n * lanes + b] with lanes = K rounded up to SPU_BUS_LANES, so a
+ * tap is resolved once per call for every bus and each read or write moves
+ * SPU_BUS_LANES buses in one SIMD op. Padding lanes only ever see silence.
+ *
+ * The resamplers stay per bus (their kernels already fill the SIMD lanes
+ * with one bus's channels and polyphase branches) and so do passes 1 and 5.
+ * process_block_multi takes K int16 buffers; process_block and
+ * process_block_f32 drive bus 0 alone. Multi-bus instances run the Float
+ * engine whatever `engine` says, hold one frame per bus in carry mode on
+ * odd block sizes like single instances, and do without freeze, snapshots
+ * and the state_bin tail.
+ * ============================================================================ */
+
+/* Saturating store of lane group g at a position < size + WORK_GUARD,
+ * keeping the guard in sync like workarea_store */
+static inline void workarea_store_lanes(workarea_t *wa, uint32_t lanes, uint32_t g,
+                                        uint32_t pos, lanes_t v) {
+    int16_t q[SPU_BUS_LANES];
+    lanes_sat(v, q);
+    pos &= wa->size_mask;
+    memcpy(wa->buf + pos * lanes + g, q, sizeof(q));
+    if (pos < WORK_GUARD) memcpy(wa->buf + (pos + wa->size_mask + 1) * lanes + g, q, sizeof(q));
+}
+
+/* Pass 3 for every bus: spu_run (generic) one lane group at a time, with
+ * the same operation order per lane. in/out hold `lanes` samples per tick,
+ * bus-interleaved; out may alias in. */
+static void spu_run_bus(workarea_t *wa, scaled_preset_t *p, const spu_volumes_t *step,
+                        const float *in_l, const float *in_r,
+                        float *out_l, float *out_r, int ticks, uint32_t lanes) {
+    const float vIIR = p->vIIR_f;
+    const float vCOMB1 = p->vCOMB1_f, vCOMB2 = p->vCOMB2_f;
+    const float vCOMB3 = p->vCOMB3_f, vCOMB4 = p->vCOMB4_f;
+    const float vAPF1 = p->vAPF1_f, vAPF2 = p->vAPF2_f;
+    float vWALL = p->vWALL_f;
+    float vLIN = p->vLIN_f, vRIN = p->vRIN_f;
+    float vLOUT = p->vLOUT_f, vROUT = p->vROUT_f;
+
+    const int16_t *buf = wa->buf;
+    uint32_t ix[TAP_COUNT];
+    for (int i = 0; i < TAP_COUNT; i++) ix[i] = (wa->base + p->taps.off[i]) & wa->size_mask;
+
+    for (int t = 0; t < ticks; t++) {
+        for (uint32_t g = 0; g < lanes; g += SPU_BUS_LANES) {
+#define RD(tap) lanes_read(buf + (ix[tap] + (uint32_t)t) * lanes + g)
+#define WR(tap, v) workarea_store_lanes(wa, lanes, g, ix[tap] + (uint32_t)t, v)
+            lanes_t Lin = lanes_scale(lanes_load(in_l + (size_t)t * lanes + g), vLIN);
+            lanes_t Rin = lanes_scale(lanes_load(in_r + (size_t)t * lanes + g), vRIN);
+
+            /* Same-side, then different-side reflection */
+            lanes_t fb = RD(TAP_FB + 0), iir = RD(TAP_HIST + 0);
+            WR(TAP_REFL + 0, lanes_add(lanes_scale(lanes_sub(lanes_add(Lin, lanes_scale(fb, vWALL)), iir), vIIR), iir));
+            fb = RD(TAP_FB + 1); iir = RD(TAP_HIST + 1);
+            WR(TAP_REFL + 1, lanes_add(lanes_scale(lanes_sub(lanes_add(Rin, lanes_scale(fb, vWALL)), iir), vIIR), iir));
+            fb = RD(TAP_FB + 2); iir = RD(TAP_HIST + 2);
+            WR(TAP_REFL + 2, lanes_add(lanes_scale(lanes_sub(lanes_add(Lin, lanes_scale(fb, vWALL)), iir), vIIR), iir));
+            fb = RD(TAP_FB + 3); iir = RD(TAP_HIST + 3);
+            WR(TAP_REFL + 3, lanes_add(lanes_scale(lanes_sub(lanes_add(Rin, lanes_scale(fb, vWALL)), iir), vIIR), iir));
+
+            /* Comb filter bank */
+            lanes_t Lout = lanes_add(lanes_scale(RD(TAP_COMB + 0), vCOMB1), lanes_scale(RD(TAP_COMB + 2), vCOMB2));
+            lanes_t Rout = lanes_add(lanes_scale(RD(TAP_COMB + 1), vCOMB1), lanes_scale(RD(TAP_COMB + 3), vCOMB2));
+            Lout = lanes_add(Lout, lanes_scale(RD(TAP_COMB + 4), vCOMB3));
+            Rout = lanes_add(Rout, lanes_scale(RD(TAP_COMB + 5), vCOMB3));
+            Lout = lanes_add(Lout, lanes_scale(RD(TAP_COMB + 6), vCOMB4));
+            Rout = lanes_add(Rout, lanes_scale(RD(TAP_COMB + 7), vCOMB4));
+
+            /* All-pass filters 1 and 2 */
+            lanes_t del = RD(TAP_APF_DEL + 0);
+            Lout = lanes_sub(Lout, lanes_scale(del, vAPF1));
+            WR(TAP_APF + 0, Lout);
+            Lout = lanes_add(lanes_scale(Lout, vAPF1), del);
+            del = RD(TAP_APF_DEL + 1);
+            Rout = lanes_sub(Rout, lanes_scale(del, vAPF1));
+            WR(TAP_APF + 1, Rout);
+            Rout = lanes_add(lanes_scale(Rout, vAPF1), del);
+            del = RD(TAP_APF_DEL + 2);
+            Lout = lanes_sub(Lout, lanes_scale(del, vAPF2));
+            WR(TAP_APF + 2, Lout);
+            Lout = lanes_add(lanes_scale(Lout, vAPF2), del);
+            del = RD(TAP_APF_DEL + 3);
+            Rout = lanes_sub(Rout, lanes_scale(del, vAPF2));
+            WR(TAP_APF + 3, Rout);
+            Rout = lanes_add(lanes_scale(Rout, vAPF2), del);
+
+            lanes_store(out_l + (size_t)t * lanes + g, lanes_scale(Lout, vLOUT));
+            lanes_store(out_r + (size_t)t * lanes + g, lanes_scale(Rout, vROUT));
+#undef RD
+#undef WR
+        }
+        if (step) {
+            vWALL += step->vWALL;
+            vLIN += step->vLIN;
+            vRIN += step->vRIN;
+            vLOUT += step->vLOUT;
+            vROUT += step->vROUT;
+        }
+    }
+    workarea_advance(wa, (uint32_t)ticks);
+
+    if (step) {
+        p->vWALL_f = vWALL;
+        p->vLIN_f = vLIN;
+        p->vRIN_f = vRIN;
+        p->vLOUT_f = vLOUT;
+        p->vROUT_f = vROUT;
+    }
+}
+
+/* Bus-interleaved SPU-rate buffers, BLOCK_TICKS ticks of up to
+ * PSXVERB_MAX_BUSES lanes */
+typedef struct {
+    float in_l[PSXVERB_MAX_BUSES][BLOCK_FRAMES], in_r[PSXVERB_MAX_BUSES][BLOCK_FRAMES];
+    float tick_l[BLOCK_TICKS * PSXVERB_MAX_BUSES], tick_r[BLOCK_TICKS * PSXVERB_MAX_BUSES];
+    float fade_l[BLOCK_TICKS * PSXVERB_MAX_BUSES], fade_r[BLOCK_TICKS * PSXVERB_MAX_BUSES];
+} bus_scratch_t;
+
+/* v2_process_frames over io[0..buses) with even frames. Buses past `buses`
+ * (up to inst->buses) get silence. */
+static void v2_process_frames_multi(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    block_scratch_t s;
+    bus_scratch_t m;
+    const uint32_t lanes = inst->lanes;
+    v2_consume_params(inst);
+    v2_update_cores(inst);
+    inst->started = 1;
+
+    int in_active = 0;
+    for (int b = 0; b < buses; b++) in_active |= io_active(&io[b], frames);
+    if (inst->sleeping) {
+        if (!in_active) {
+            v2_idle_block(inst);
+            return;
+        }
+        inst->sleeping = 0;
+        inst->quiet_ticks = 0;
+    }
+    float wet_peak = 0.0f;
+
+    if (inst->params_dirty) {
+        inst->params_dirty = 0;
+        v2_begin_ramp(inst);
+    }
+    const resampler_kernels_t *rs = &g_resamplers[inst->live.resampler];
+
+    for (int off = 0; off < frames; ) {
+        int n = frames - off;
+        if (n > BLOCK_FRAMES) n = BLOCK_FRAMES;
+        int ticks = n / 2;
+        spu_core_t *core = &inst->core[inst->active];
+        const float *dry_l[PSXVERB_MAX_BUSES], *dry_r[PSXVERB_MAX_BUSES];
+
+        if (inst->live.resampler == RESAMPLER_IIR) v2_count_denormals(inst);
+
+        /* Passes 1-2 per bus, then into the bus lanes */
+        for (int b = 0; b < buses; b++) {
+            hb_decimator_t *down = b ? &inst->bus[b - 1].down : &inst->down;
+            hb_mono_decimator_t *mono = b ? &inst->bus[b - 1].down_mono : &inst->down_mono;
+            io_load(&io[b], off, n, m.in_l[b], m.in_r[b], &dry_l[b], &dry_r[b]);
+            if (inst->live.routing == ROUTING_MONO) {
+                rs->decimate_mono(mono, dry_l[b], dry_r[b], s.tick_l, s.tick_r, ticks);
+            } else {
+                rs->decimate(down, dry_l[b], dry_r[b], s.tick_l, s.tick_r, ticks);
+            }
+            for (int t = 0; t < ticks; t++) {
+                m.tick_l[t * lanes + b] = s.tick_l[t];
+                m.tick_r[t * lanes + b] = s.tick_r[t];
+            }
+        }
+        for (uint32_t b = (uint32_t)buses; b < lanes; b++) {
+            for (int t = 0; t < ticks; t++) m.tick_l[t * lanes + b] = m.tick_r[t * lanes + b] = 0.0f;
+        }
+
+        /* Pass 3, every bus at once */
+        if (inst->fade_remaining > 0) {
+            spu_run_bus(&inst->core[inst->active ^ 1].work, &inst->fade_preset, NULL,
+                        m.tick_l, m.tick_r, m.fade_l, m.fade_r, ticks, lanes);
+        }
+        int r = v2_ramp_ticks(inst, ticks);
+        if (r > 0) {
+            spu_run_bus(&core->work, &inst->current, &inst->ramp_step,
+                        m.tick_l, m.tick_r, m.tick_l, m.tick_r, r, lanes);
+            if (inst->ramp_remaining == 0) v2_snap_volumes(inst);
+        }
+        if (r < ticks) {
+            spu_run_bus(&core->work, &inst->current, NULL,
+                        m.tick_l + r * lanes, m.tick_r + r * lanes,
+                        m.tick_l + r * lanes, m.tick_r + r * lanes, ticks - r, lanes);
+        }
+
+        /* Passes 3b-5 per bus, each from the same fade and mix positions */
+        int rf = r * 2;
+        uint32_t fade_left = inst->fade_remaining;
+        float mix_end = (inst->ramp_remaining == 0) ? inst->live.mix
+                                                    : inst->mix_cur + inst->mix_step * (float)rf;
+        for (int b = 0; b < buses; b++) {
+            hb_interpolator_t *up = b ? &inst->bus[b - 1].up : &inst->up;
+            float *out_l, *out_r;
+            io_out(&io[b], off, s.wet_l, s.wet_r, &out_l, &out_r);
+            for (int t = 0; t < ticks; t++) {
+                s.tick_l[t] = m.tick_l[t * lanes + b];
+                s.tick_r[t] = m.tick_r[t * lanes + b];
+            }
+            if (inst->fade_remaining > 0) {
+                for (int t = 0; t < ticks; t++) {
+                    s.fade_l[t] = m.fade_l[t * lanes + b];
+                    s.fade_r[t] = m.fade_r[t * lanes + b];
+                }
+                fade_left = inst->fade_remaining;
+                block_crossfade(s.tick_l, s.tick_r, s.fade_l, s.fade_r,
+                                &fade_left, inst->fade_ticks, ticks);
+            }
+            wet_peak = max_f(wet_peak, block_peak_f(s.tick_l, s.tick_r, ticks));
+
+            if (inst->live.routing != ROUTING_INSERT) {
+                rs->interpolate(up, s.tick_l, s.tick_r, s.wet_l, s.wet_r, ticks);
+                block_mix_wet(dry_l[b], dry_r[b], s.wet_l, s.wet_r, 1.0f, out_l, out_r, n);
+                io_store(&io[b], off, out_l, out_r, n);
+                continue;
+            }
+
+            float mix = inst->mix_cur;
+            int mode = (r > 0) ? MIX_BLEND : mix_mode(mix);
+            if (mode == MIX_DRY) continue;
+            rs->interpolate(up, s.tick_l, s.tick_r, s.wet_l, s.wet_r, ticks);
+            if (rf > 0) {
+                mix = block_mix_ramp(dry_l[b], dry_r[b], s.wet_l, s.wet_r,
+                                     mix, inst->mix_step, out_l, out_r, rf);
+                io_store(&io[b], off, out_l, out_r, rf);
+                if (inst->ramp_remaining == 0) mix = inst->live.mix;
+                mix_end = mix;
+            }
+            mode = mix_mode(mix);
+            if (rf < n && mode != MIX_DRY) {
+                g_mix_kernels[mode](dry_l[b] + rf, dry_r[b] + rf, s.wet_l + rf, s.wet_r + rf,
+                                    mix, out_l + rf, out_r + rf, n - rf);
+                io_store(&io[b], off + rf, out_l + rf, out_r + rf, n - rf);
+            }
+        }
+        inst->fade_remaining = fade_left;
+        inst->mix_cur = mix_end;
+        off += n;
+    }
+
+    v2_track_silence(inst, in_active, wet_peak, frames / 2);
+}
+
+/* ============================================================================
+ * METERING
+ * Every process call adds the host buffer's peak and energy before and
+ * after the pipeline (all buses of a multi-bus instance) and scans the next
+ * METER_SWEEP work area samples for level and occupancy. The loops are
+ * branch-free reductions the compiler vectorizes. Once per METER_WINDOW_MS
+ * the window goes out through a seqlock, which the UI side retries on
+ * instead of ever blocking the audio thread; get_param("meters") turns it
+ * into dB and RT60 estimates:
+ * - rt60_model_s: -60 dB time of the same-side reflection loop, gain
+ *   |vWALL| * |IIR(METER_RT60_HZ)| per loop length
+ * - rt60_measured_s: from the output level drop between windows while the
+ *   input is silent, smoothed
+ * Build with -DPSXVERB_NO_METERS to leave it all out.
+ * ============================================================================ */
+
+#ifdef PSXVERB_NO_METERS
+#define PSXVERB_METERS 0
+#else
+#define PSXVERB_METERS 1
+#endif
+
+#define METER_WINDOW_MS 50
+#define METER_SWEEP 256             /* Work area samples scanned per call */
+#define METER_OCCUPIED 4            /* |sample| above this counts as occupied */
+#define METER_SILENT 1e-5f          /* Input peak below this lets the decay be measured */
+#define METER_FLOOR_DB -120.0f
+#define METER_RT60_HZ 500.0f
+#define METER_RT60_MAX 60.0f
+
+/* Peak and energy of frames [0, frames) of a host buffer, full scale 1.0 */
+static void io_meter(const block_io_t *io, int frames, float *peak, float *energy) {
+    float pk = 0.0f, e = 0.0f;
+    if (io->i16) {
+        for (int i = 0; i < frames * 2; i++) {
+            float x = (float)io->i16[i] * kInt16ToFloat;
+            pk = max_f(pk, abs_f(x));
+            e += x * x;
+        }
+    } else {
+        for (int i = 0; i < frames; i++) {
+            float l = io->l[i * io->stride], r = io->r[i * io->stride];
+            pk = max_f(pk, max_f(abs_f(l), abs_f(r)));
+            e += l * l + r * r;
+        }
+    }
+    *peak = max_f(*peak, pk);
+    *energy += e;
+}
+
+/* Audio side: input half, before the pipeline runs in place */
+static void v2_meter_input(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    meter_acc_t *m = &inst->meter;
+    for (int b = 0; b < buses; b++) io_meter(&io[b], frames, &m->in_peak, &m->in_energy);
+}
+
+/* Next stretch of the work area sweep; padding lanes are always zero,
+ * so occupancy counts real buses only */
+static void meter_sweep(psxverb_instance_t *inst) {
+    meter_acc_t *m = &inst->meter;
+    const workarea_t *wa = &inst->core[inst->active].work;
+    uint32_t total = (wa->size_mask + 1) * inst->lanes;
+    uint32_t pos = m->sweep_pos < total ? m->sweep_pos : total;
+    uint32_t n = total - pos < METER_SWEEP ? total - pos : METER_SWEEP;
+    const int16_t *p = wa->buf + pos;
+    float e = 0.0f;
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x = p[i];
+        e += (float)(x * x);
+        active += (uint32_t)(x * x > METER_OCCUPIED * METER_OCCUPIED);
+    }
+    m->sweep_energy += e;
+    m->sweep_active += active;
+    m->sweep_count += n;
+    m->sweep_pos = pos + n;
+    if (m->sweep_pos < total) return;
+
+    float real = (float)m->sweep_count * (float)inst->buses / (float)inst->lanes;
+    m->work_ms = m->sweep_energy * (kInt16ToFloat * kInt16ToFloat) / (float)m->sweep_count;
+    m->occupancy = (float)m->sweep_active / real;
+    m->sweep_pos = m->sweep_count = m->sweep_active = 0;
+    m->sweep_energy = 0.0f;
+}
+
+static void meter_publish(meter_pub_t *pub, const float *v) {
+    uint32_t seq = atomic_load_explicit(&pub->seq, memory_order_relaxed);
+    atomic_store_explicit(&pub->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (int i = 0; i < METER_COUNT; i++) atomic_store_explicit(&pub->v[i], v[i], memory_order_relaxed);
+    atomic_store_explicit(&pub->seq, seq + 2, memory_order_release);
+}
+
+/* UI side: a consistent copy of the last window. Returns the window count. */
+static uint32_t meter_read(meter_pub_t *pub, float *v) {
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(&pub->seq, memory_order_acquire);
+        if (seq & 1) continue;
+        for (int i = 0; i < METER_COUNT; i++) v[i] = atomic_load_explicit(&pub->v[i], memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&pub->seq, memory_order_relaxed) == seq) return seq / 2;
+    }
+}
+
+/* Audio side: output half, the sweep step and, at the end of a window,
+ * the publish */
+static void v2_meter_output(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    meter_acc_t *m = &inst->meter;
+    for (int b = 0; b < buses; b++) io_meter(&io[b], frames, &m->out_peak, &m->out_energy);
+    m->samples += (uint32_t)(frames * 2 * buses);
+    m->frames += (uint32_t)frames;
+    meter_sweep(inst);
+    if (m->frames < (uint32_t)(inst->sample_rate * METER_WINDOW_MS / 1000)) return;
+
+    float in_ms = m->in_energy / (float)m->samples;
+    float out_ms = m->out_energy / (float)m->samples;
+    if (m->in_peak < METER_SILENT && out_ms > 0.0f && out_ms < m->prev_out_ms) {
+        float drop_db = 10.0f * log10f(m->prev_out_ms / out_ms);
+        float window_s = (float)m->frames / (float)inst->sample_rate;
+        float rt60 = min_f(60.0f * window_s / drop_db, METER_RT60_MAX);
+        m->rt60 = m->rt60 > 0.0f ? m->rt60 + (rt60 - m->rt60) * 0.25f : rt60;
+    }
+    m->prev_out_ms = m->in_peak < METER_SILENT ? out_ms : 0.0f;  /* Only tail-to-tail drops count */
+
+    const scaled_preset_t *p = &inst->current;
+    float v[METER_COUNT];
+    v[METER_IN_PEAK] = m->in_peak;
+    v[METER_IN_MS] = in_ms;
+    v[METER_OUT_PEAK] = m->out_peak;
+    v[METER_OUT_MS] = out_ms;
+    v[METER_WORK_MS] = m->work_ms;
+    v[METER_OCCUPANCY] = m->occupancy;
+    v[METER_WALL] = p->vWALL_f;
+    v[METER_IIR] = p->vIIR_f;
+    v[METER_LOOP_TICKS] = (float)((p->taps.off[TAP_REFL] - p->taps.off[TAP_FB]) &
+                                  inst->core[inst->active].work.size_mask);
+    v[METER_RT60_MEASURED] = m->rt60;
+    meter_publish(&inst->meters, v);
+
+    m->in_peak = m->out_peak = 0.0f;
+    m->in_energy = m->out_energy = 0.0f;
+    m->samples = m->frames = 0;
+}
+
+static float meter_db(float linear) {
+    return linear > 0.0f ? max_f(20.0f * log10f(linear), METER_FLOOR_DB) : METER_FLOOR_DB;
+}
+
+/* meters JSON (UI thread) */
+static int v2_get_meters(psxverb_instance_t *inst, char *buf, int buf_len) {
+    float v[METER_COUNT];
+    uint32_t windows = meter_read(&inst->meters, v);
+
+    /* Loop gain at METER_RT60_HZ: |vWALL| times the one-pole IIR
+     * vIIR / |1 - (1 - vIIR) e^-jw| at the SPU tick rate */
+    float w = 2.0f * 3.14159265f * METER_RT60_HZ / ((float)inst->sample_rate * 0.5f);
+    float a = v[METER_IIR], c = 1.0f - a;
+    float iir = a / sqrtf(max_f(1.0f - 2.0f * c * cosf(w) + c * c, 1e-12f));
+    float gain = abs_f(v[METER_WALL]) * iir;
+    float rt60 = 0.0f;
+    if (gain > 0.0f && v[METER_LOOP_TICKS] > 0.0f) {
+        float loop_s = v[METER_LOOP_TICKS] / ((float)inst->sample_rate * 0.5f);
+        rt60 = gain < 1.0f ? min_f(-3.0f * loop_s / log10f(gain), METER_RT60_MAX) : METER_RT60_MAX;
+    }
+
+    return snprintf(buf, buf_len,
+        "{\"in_peak_db\":%.1f,\"in_rms_db\":%.1f,\"out_peak_db\":%.1f,\"out_rms_db\":%.1f,"
+        "\"work_rms_db\":%.1f,\"occupancy\":%.3f,\"rt60_model_s\":%.2f,\"rt60_measured_s\":%.2f,"
+        "\"windows\":%u}",
+        (double)meter_db(v[METER_IN_PEAK]), (double)meter_db(sqrtf(v[METER_IN_MS])),
+        (double)meter_db(v[METER_OUT_PEAK]), (double)meter_db(sqrtf(v[METER_OUT_MS])),
+        (double)meter_db(sqrtf(v[METER_WORK_MS])), (double)v[METER_OCCUPANCY],
+        (double)rt60, (double)v[METER_RT60_MEASURED], windows);
+}
+
+/* ============================================================================
+ * ARBITRARY BLOCK SIZES
+ * The pipeline consumes whole frame pairs, one SPU tick each. While the host
+ * sends even frame counts, blocks go straight through. The first odd count
+ * switches the instance to carry mode for good: an unpaired trailing input
+ * frame is held over to the next call and the output runs one frame late,
+ * so every call returns `frames` processed frames and the 2:1 decimation
+ * phase carries across calls. Entering carry mode repeats the previous
+ * output frame once. Multi-bus instances hold one frame per bus.
+ *
+ * Per-call overhead is a parameter check, one 4096-sample clearing step
+ * while a retired core is dirty, and resolving the tap program, so 32 or 64
+ * frame blocks cost about the same per frame as 128 (within ~10% at 32,
+ * measure with psxverb_bench -f).
+ * ============================================================================ */
+
+static void v2_process_carry(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    union {
+        int16_t i16[PSXVERB_MAX_BUSES][BLOCK_FRAMES * 2];
+        float f32[PSXVERB_MAX_BUSES][2][BLOCK_FRAMES];
+    } buf;
+    block_io_t stage[PSXVERB_MAX_BUSES];
+    for (int b = 0; b < buses; b++) {
+        stage[b] = io->i16 ? io_int16(buf.i16[b]) : io_f32(buf.f32[b][0], buf.f32[b][1], 1);
+    }
+    /* Buses left out of this call run on silence */
+    for (int b = buses; b < inst->buses; b++) {
+        inst->carry_in[b][0] = inst->carry_in[b][1] = 0.0f;
+        inst->carry_out[b][0] = inst->carry_out[b][1] = 0.0f;
+    }
+
+    for (int pos = 0; pos < frames; ) {
+        int held = inst->carry_held;
+        int m = frames - pos;
+        if (m > BLOCK_FRAMES - held) m = BLOCK_FRAMES - held;
+
+        /* Held frame first, then this chunk; process every whole pair */
+        for (int b = 0; b < buses; b++) {
+            if (held) io_put_frame(&stage[b], 0, inst->carry_in[b]);
+            io_copy(&stage[b], held, &io[b], pos, m);
+        }
+        int total = held + m;
+        int even = total & ~1;
+        if (inst->lanes > 1) {
+            v2_process_frames_multi(inst, stage, buses, even);
+        } else {
+            v2_process_frames(inst, stage, even);
+        }
+        inst->carry_held = total & 1;
+
+        /* Emit one frame behind. Exactly one processed frame is pending
+         * between calls whenever no input frame is held. */
+        for (int b = 0; b < buses; b++) {
+            if (inst->carry_held) io_get_frame(&stage[b], even, inst->carry_in[b]);
+            int dst = pos;
+            int n = m;
+            if (!held) {
+                io_put_frame(&io[b], dst, inst->carry_out[b]);
+                dst++;
+                n--;
+            }
+            io_copy(&io[b], dst, &stage[b], 0, n);
+            if (!inst->carry_held) io_get_frame(&stage[b], n, inst->carry_out[b]);
+        }
+        pos += m;
+    }
+}
+
+/* Run one host call of either sample type over io[0..buses) */
+static void v2_process_io(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    fp_env_t env = fp_env_enter();
+    if (PSXVERB_METERS) v2_meter_input(inst, io, buses, frames);
+    if (!inst->carry_mode && !(frames & 1)) {
+        if (inst->lanes > 1) {
+            v2_process_frames_multi(inst, io, buses, frames);
+        } else {
+            v2_process_frames(inst, io, frames);
+        }
+        for (int b = 0; b < buses; b++) io_get_frame(&io[b], frames - 1, inst->carry_out[b]);
+    } else {
+        if (!inst->carry_mode) {
+            inst->carry_mode = 1;
+            inst->carry_held = 0;
+            atomic_store_explicit(&inst->carry_latency, 1, memory_order_relaxed);
+        }
+        v2_process_carry(inst, io, buses, frames);
+    }
+    if (PSXVERB_METERS) v2_meter_output(inst, io, buses, frames);
+    fp_env_leave(env);
+}
+
+#if PSXVERB_PROFILE
+/* v2_process_io with timing and event counts (audio thread) */
+static void v2_process_io_profiled(psxverb_instance_t *inst, const block_io_t *io, int buses, int frames) {
+    perf_stats_t *ps = &inst->perf;
+
+    if (atomic_exchange_explicit(&ps->reset, 0, memory_order_acquire)) {
+        atomic_store_explicit(&ps->calls, 0, memory_order_relaxed);
+        atomic_store_explicit(&ps->saturations, 0, memory_order_relaxed);
+        atomic_store_explicit(&ps->clips, 0, memory_order_relaxed);
+    }
+    t_perf_saturations = 0;
+    t_perf_clips = 0;
+
+    uint64_t t0 = perf_now();
+    v2_process_io(inst, io, buses, frames);
+    uint64_t dt = perf_now() - t0;
+
+    uint32_t n = atomic_load_explicit(&ps->calls, memory_order_relaxed);
+    atomic_store_explicit(&ps->window[n % PERF_WINDOW],
+                          dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt, memory_order_relaxed);
+    atomic_store_explicit(&ps->calls, n + 1, memory_order_release);
+    atomic_store_explicit(&ps->saturations,
+                          atomic_load_explicit(&ps->saturations, memory_order_relaxed) + t_perf_saturations,
+                          memory_order_relaxed);
+    atomic_store_explicit(&ps->clips,
+                          atomic_load_explicit(&ps->clips, memory_order_relaxed) + t_perf_clips,
+                          memory_order_relaxed);
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* perf_stats JSON over the rolling window (UI thread). Entries may be from
+ * adjacent calls while the audio thread writes; fine for a summary. */
+static int v2_get_perf_stats(psxverb_instance_t *inst, char *buf, int buf_len) {
+    const perf_stats_t *ps = &inst->perf;
+    uint32_t sorted[PERF_WINDOW];
+    uint32_t calls = atomic_load_explicit(&ps->calls, memory_order_acquire);
+    uint32_t n = calls < PERF_WINDOW ? calls : PERF_WINDOW;
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        sorted[i] = atomic_load_explicit(&ps->window[i], memory_order_relaxed);
+        sum += sorted[i];
+    }
+    qsort(sorted, n, sizeof(sorted[0]), cmp_u32);
+
+    double to_ns = 1e9 / (double)g_perf_freq;
+    double min_ns = n ? sorted[0] * to_ns : 0.0;
+    double max_ns = n ? sorted[n - 1] * to_ns : 0.0;
+    double p99_ns = n ? sorted[(n * 99) / 100] * to_ns : 0.0;
+    double mean_ns = n ? (double)sum / n * to_ns : 0.0;
+    double budget_ns = 1e9 * MOVE_FRAMES_PER_BLOCK / (double)inst->sample_rate;
+
+    return snprintf(buf, buf_len,
+        "{\"calls\":%u,\"window\":%u,\"min_ns\":%.0f,\"mean_ns\":%.0f,"
+        "\"p99_ns\":%.0f,\"max_ns\":%.0f,\"load\":%.4f,"
+        "\"saturations\":%u,\"clips\":%u}",
+        calls, n, min_ns, mean_ns, p99_ns, max_ns, mean_ns / budget_ns,
+        atomic_load_explicit(&ps->saturations, memory_order_relaxed),
+        atomic_load_explicit(&ps->clips, memory_order_relaxed));
+}
+#endif
+
+#if PSXVERB_PROFILE
+#define V2_PROCESS_IO v2_process_io_profiled
+#else
+#define V2_PROCESS_IO v2_process_io
+#endif
+
+/* v2 API: process block, interleaved int16 */
+static void v2_process_block(void *instance, int16_t *audio_inout, int frames) {
+    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
+    if (!inst || frames <= 0) return;
+    block_io_t io = io_int16(audio_inout);
+    V2_PROCESS_IO(inst, &io, 1, frames);
+}
+
+/* v2 API (AUDIO_FX_API_VERSION_2_F32): process block in float, in place.
+ * Sample i of each channel is at left[i * stride] and right[i * stride]. */
+static void v2_process_block_f32(void *instance, float *left, float *right, int stride, int frames) {
+    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
+    if (!inst || !left || !right || stride < 1 || frames <= 0) return;
+    block_io_t io = io_f32(left, right, stride);
+    V2_PROCESS_IO(inst, &io, 1, frames);
+}
+
+/* v2 API (AUDIO_FX_API_VERSION_2_MULTI): one interleaved int16 buffer per
+ * bus. Buses past the instance's own are left untouched; a plain instance
+ * processes the first one. */
+static void v2_process_block_multi(void *instance, int16_t *const *audio_inout, int buses, int frames) {
+    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
+    if (!inst || !audio_inout || buses <= 0 || frames <= 0) return;
+    if (buses > inst->buses) buses = inst->buses;
+    block_io_t io[PSXVERB_MAX_BUSES];
+    for (int b = 0; b < buses; b++) {
+        if (!audio_inout[b]) return;
+        io[b] = io_int16(audio_inout[b]);
+    }
+    V2_PROCESS_IO(inst, io, buses, frames);
+}
+
+/* v2 helper: UI-side preset selection, returns 0 if the preset can be used */
+static int v2_select_preset(psxverb_instance_t *inst, int idx) {
+    if (idx < 0 || idx >= g_preset_count) return -1;
+    if (v2_reserve_spare(inst, inst->rates->work_samples[idx]) != 0) return -1;
+    inst->ui.preset = idx;
+    return 0;
+}
+
+/* ============================================================================
+ * STATE SAVE / RESTORE
+ * "state" is the JSON patch blob: parsed in one pass, and serialized once
+ * per change (cached until the next set_param). "state_bin" is a versioned
+ * binary image of the same parameters plus, when it fits the host buffer,
+ * the active work area, base64 encoded. Restoring it on a matching sample
+ * rate resumes the tail where it was saved instead of starting the preset
+ * from silence: the UI fills a fresh work buffer and the audio thread swaps
+ * it in. Capturing asks the audio thread for one memcpy of the work area
+ * and waits up to STATE_CAPTURE_WAIT_MS for it (no tail if the host is not
+ * processing). UI thread only, apart from the two handoffs in
+ * v2_update_cores.
+ * ============================================================================ */
+
+/* State keys, in psxverb_params_t order */
+enum {
+    STATE_PRESET, STATE_DECAY, STATE_MIX, STATE_INPUT_GAIN, STATE_REVERB_LEVEL,
+    STATE_CROSSFADE, STATE_ENGINE, STATE_ROUTING, STATE_RESAMPLER, STATE_KEY_COUNT
+};
+
+static const char *const g_state_keys[STATE_KEY_COUNT] = {
+    "preset", "decay", "mix", "input_gain", "reverb_level",
+    "crossfade", "engine", "routing", "resampler"
+};
+
+typedef struct {
+    float v[STATE_KEY_COUNT];
+    uint32_t present;           /* Bit per key found */
+} state_fields_t;
+
+#define STATE_HAS(f, k) ((f)->present & (1u << (k)))
+
+/* Single pass over a JSON object of numbers. Unknown keys and non-numeric
+ * values are skipped. */
+static void state_parse_json(const char *p, state_fields_t *f) {
+    f->present = 0;
+    while (*p) {
+        if (*p++ != '"') continue;
+        const char *key = p;
+        while (*p && *p != '"') p += (*p == '\\' && p[1]) ? 2 : 1;
+        if (!*p) return;
+        size_t len = (size_t)(p++ - key);
+        while (*p == ' ') p++;
+        if (*p != ':') continue;    /* A string value, not a key */
+        p++;
+        while (*p == ' ') p++;
+        char *end;
+        float v = strtof(p, &end);
+        if (end == p) continue;     /* Strings and nesting: keep scanning */
+        p = end;
+        for (int k = 0; k < STATE_KEY_COUNT; k++) {
+            if (strncmp(key, g_state_keys[k], len) == 0 && g_state_keys[k][len] == '\0') {
+                f->v[k] = v;
+                f->present |= 1u << k;
+                break;
+            }
+        }
+    }
+}
+
+/* Apply parsed fields to the UI parameter set. A preset change goes through
+ * the usual crossfade. */
+static void v2_apply_state(psxverb_instance_t *inst, const state_fields_t *f) {
+    psxverb_params_t *ui = &inst->ui;
+    if (STATE_HAS(f, STATE_PRESET)) {
+        int idx = (int)f->v[STATE_PRESET];
+        if (idx >= 0 && idx < g_preset_count && idx != ui->preset) {
+            v2_select_preset(inst, idx);
+        }
+    }
+    if (STATE_HAS(f, STATE_DECAY)) ui->decay = clamp_f(f->v[STATE_DECAY], 0.0f, 1.0f);
+    if (STATE_HAS(f, STATE_MIX)) ui->mix = clamp_f(f->v[STATE_MIX], 0.0f, 1.0f);
+    if (STATE_HAS(f, STATE_INPUT_GAIN)) ui->input_gain = clamp_f(f->v[STATE_INPUT_GAIN], 0.0f, 1.0f);
+    if (STATE_HAS(f, STATE_REVERB_LEVEL)) ui->reverb_level = clamp_f(f->v[STATE_REVERB_LEVEL], 0.0f, 1.0f);
+    if (STATE_HAS(f, STATE_CROSSFADE)) ui->crossfade_ms = clamp_f(f->v[STATE_CROSSFADE], 0.0f, CROSSFADE_MAX_MS);
+    if (STATE_HAS(f, STATE_ENGINE)) {
+        int e = (int)f->v[STATE_ENGINE];
+        if (e >= 0 && e < ENGINE_COUNT) ui->engine = e;
+    }
+    if (STATE_HAS(f, STATE_ROUTING)) {
+        int rt = (int)f->v[STATE_ROUTING];
+        if (rt >= 0 && rt < ROUTING_COUNT) ui->routing = rt;
+    }
+    if (STATE_HAS(f, STATE_RESAMPLER)) {
+        int rs = (int)f->v[STATE_RESAMPLER];
+        if (rs >= 0 && rs < RESAMPLER_COUNT) ui->resampler = rs;
+    }
+}
+
+/* Copy a pre-built string of known length out through get_param */
+static int copy_blob(char *buf, int buf_len, const char *src, int len) {
+    if (len >= buf_len) return -1;
+    memcpy(buf, src, (size_t)len + 1);
+    return len;
+}
+
+static int v2_get_state_json(psxverb_instance_t *inst, char *buf, int buf_len) {
+    if (inst->state_json_len == 0) {
+        const psxverb_params_t *ui = &inst->ui;
+        int n = snprintf(inst->state_json, sizeof(inst->state_json),
+            "{\"preset\":%d,\"decay\":%.4f,\"mix\":%.4f,"
+            "\"input_gain\":%.4f,\"reverb_level\":%.4f,\"crossfade\":%.0f,"
+            "\"engine\":%d,\"routing\":%d,\"resampler\":%d}",
+            ui->preset, ui->decay, ui->mix,
+            ui->input_gain, ui->reverb_level, ui->crossfade_ms,
+            ui->engine, ui->routing, ui->resampler);
+        if (n <= 0 || n >= (int)sizeof(inst->state_json)) return -1;
+        inst->state_json_len = n;
+    }
+    return copy_blob(buf, buf_len, inst->state_json, inst->state_json_len);
+}
+
+#define STATE_BIN_VERSION 1
+#define STATE_CAPTURE_WAIT_MS 50
+
+/* Binary state header, little-endian; tail_samples int16 follow it */
+typedef struct {
+    char magic[4];          /* "PSXS" */
+    uint16_t version;       /* STATE_BIN_VERSION */
+    uint16_t reserved;
+    int32_t sample_rate;    /* Rate the work area was captured at */
+    int32_t preset, engine, routing, resampler;
+    float decay, mix, input_gain, reverb_level, crossfade_ms;
+    int32_t tail_preset;    /* Preset owning the work area, -1 = none */
+    uint32_t tail_base;
+    uint32_t tail_samples;
+} state_bin_t;
+
+static const char g_base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static size_t base64_len(size_t bytes) {
+    return (bytes + 2) / 3 * 4;
+}
+
+static void base64_encode(const uint8_t *src, size_t n, char *dst) {
+    for (size_t i = 0; i < n; i += 3) {
+        uint32_t v = (uint32_t)src[i] << 16;
+        if (i + 1 < n) v |= (uint32_t)src[i + 1] << 8;
+        if (i + 2 < n) v |= src[i + 2];
+        *dst++ = g_base64[v >> 18];
+        *dst++ = g_base64[(v >> 12) & 63];
+        *dst++ = i + 1 < n ? g_base64[(v >> 6) & 63] : '=';
+        *dst++ = i + 2 < n ? g_base64[v & 63] : '=';
+    }
+    *dst = '\0';
+}
+
+/* Decodes up to max bytes; returns the count, or -1 on a bad character */
+static long base64_decode(const char *src, uint8_t *dst, size_t max) {
+    static int8_t lut[256];
+    if (!lut['B']) {
+        memset(lut, -1, sizeof(lut));
+        for (int i = 0; i < 64; i++) lut[(uint8_t)g_base64[i]] = (int8_t)i;
+    }
+    size_t n = 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (; *src && *src != '='; src++) {
+        int8_t d = lut[(uint8_t)*src];
+        if (d < 0) return -1;
+        acc = (acc << 6) | (uint32_t)d;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (n >= max) return -1;
+            dst[n++] = (uint8_t)(acc >> bits);
+        }
+    }
+    return (long)n;
+}
+
+/* UI side: have the audio thread copy the active work area. Returns the
+ * filled buffer (state_preset -1 if nothing was copied) or NULL. */
+static work_buf_t *v2_capture_work(psxverb_instance_t *inst) {
+    work_buf_t *w = v2_work_alloc(inst, inst->ui_work_max);
+    if (!w) return NULL;
+    v2_work_release(inst, atomic_exchange(&inst->capture_done, NULL));
+    atomic_store(&inst->capture_req, w);
+
+    const struct timespec ms = {0, 1000000};
+    for (int i = 0; i < STATE_CAPTURE_WAIT_MS; i++) {
+        work_buf_t *done = atomic_exchange(&inst->capture_done, NULL);
+        if (done) return done;
+        nanosleep(&ms, NULL);
+    }
+    /* Not processing: take the request back, unless the audio thread has
+     * just picked it up, in which case it finishes within that call */
+    if (atomic_exchange(&inst->capture_req, NULL)) {
+        v2_work_release(inst, w);
+        return NULL;
+    }
+    work_buf_t *done;
+    while (!(done = atomic_exchange(&inst->capture_done, NULL))) nanosleep(&ms, NULL);
+    return done;
+}
+
+static int v2_get_state_bin(psxverb_instance_t *inst, char *buf, int buf_len) {
+    const psxverb_params_t *ui = &inst->ui;
+    state_bin_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "PSXS", 4);
+    h.version = STATE_BIN_VERSION;
+    h.sample_rate = inst->sample_rate;
+    h.preset = ui->preset;
+    h.engine = ui->engine;
+    h.routing = ui->routing;
+    h.resampler = ui->resampler;
+    h.decay = ui->decay;
+    h.mix = ui->mix;
+    h.input_gain = ui->input_gain;
+    h.reverb_level = ui->reverb_level;
+    h.crossfade_ms = ui->crossfade_ms;
+    h.tail_preset = -1;
+
+    size_t len = base64_len(sizeof(h));
+    if (len >= (size_t)buf_len) return -1;
+
+    /* Tail only when the host buffer can take it and it belongs to the
+     * saved preset (not mid preset change) */
+    work_buf_t *w = NULL;
+    uint32_t samples = inst->rates->work_samples[ui->preset];
+    if (inst->lanes == 1 && base64_len(sizeof(h) + samples * sizeof(int16_t)) < (size_t)buf_len) {
+        w = v2_capture_work(inst);
+    }
+    uint8_t *blob = NULL;
+    if (w && w->state_preset == ui->preset) {
+        blob = (uint8_t*)malloc(sizeof(h) + samples * sizeof(int16_t));
+    }
+    if (blob) {
+        h.tail_preset = w->state_preset;
+        h.tail_base = w->state_base;
+        h.tail_samples = samples;
+        memcpy(blob, &h, sizeof(h));
+        memcpy(blob + sizeof(h), w->data, samples * sizeof(int16_t));
+        len = base64_len(sizeof(h) + samples * sizeof(int16_t));
+        base64_encode(blob, sizeof(h) + samples * sizeof(int16_t), buf);
+        free(blob);
+    } else {
+        base64_encode((const uint8_t*)&h, sizeof(h), buf);
+    }
+    v2_work_release(inst, w);
+    return (int)len;
+}
+
+/* UI side: hand a saved work area to the audio thread. The buffer is
+ * sized like any other so later preset changes can reuse it. */
+static void v2_restore_work(psxverb_instance_t *inst, const state_bin_t *h, const int16_t *tail) {
+    uint32_t samples = h->tail_samples;
+    if (samples > inst->ui_work_max) inst->ui_work_max = samples;
+    work_buf_t *w = v2_work_alloc(inst, inst->ui_work_max);
+    if (!w) {
+        /* Fall back to a plain preset switch */
+        fx_log("work area allocation failed, tail not restored");
+        v2_reserve_spare(inst, samples);
+        return;
+    }
+    memcpy(w->data, tail, samples * sizeof(int16_t));
+    memcpy(w->data + samples, w->data, WORK_GUARD * sizeof(int16_t));
+    w->state_preset = h->tail_preset;
+    w->state_base = h->tail_base;
+    v2_work_release(inst, atomic_exchange(&inst->restore_next, w));
+}
+
+static void v2_set_state_bin(psxverb_instance_t *inst, const char *val) {
+    size_t max = sizeof(state_bin_t) + WORK_MAX_SIZE * sizeof(int16_t);
+    uint8_t *blob = (uint8_t*)malloc(max);
+    if (!blob) return;
+    long n = base64_decode(val, blob, max);
+    state_bin_t h;
+    if (n < (long)sizeof(h)) {
+        free(blob);
+        return;
+    }
+    memcpy(&h, blob, sizeof(h));
+    if (memcmp(h.magic, "PSXS", 4) != 0 || h.version != STATE_BIN_VERSION ||
+        (size_t)n != sizeof(h) + (size_t)h.tail_samples * sizeof(int16_t)) {
+        free(blob);
+        return;
+    }
+
+    /* Same clamping and range checks as the JSON path */
+    state_fields_t f;
+    f.present = (1u << STATE_KEY_COUNT) - 1;
+    f.v[STATE_PRESET] = (float)h.preset;
+    f.v[STATE_DECAY] = h.decay;
+    f.v[STATE_MIX] = h.mix;
+    f.v[STATE_INPUT_GAIN] = h.input_gain;
+    f.v[STATE_REVERB_LEVEL] = h.reverb_level;
+    f.v[STATE_CROSSFADE] = h.crossfade_ms;
+    f.v[STATE_ENGINE] = (float)h.engine;
+    f.v[STATE_ROUTING] = (float)h.routing;
+    f.v[STATE_RESAMPLER] = (float)h.resampler;
+
+    /* The tail replaces the preset switch when it fits this instance. The
+     * parameters go out first so the audio thread picks up both together. */
+    int tail_ok = inst->lanes == 1 && h.tail_preset >= 0 && h.tail_preset == h.preset &&
+                  h.preset < g_preset_count && h.sample_rate == inst->sample_rate &&
+                  h.tail_samples == inst->rates->work_samples[h.preset] &&
+                  h.tail_base < h.tail_samples;
+    if (tail_ok) {
+        inst->ui.preset = h.preset;
+        f.present &= ~(1u << STATE_PRESET);
+    }
+    v2_apply_state(inst, &f);
+    if (tail_ok) {
+        mailbox_publish(&inst->mailbox, &inst->ui);
+        v2_restore_work(inst, &h, (const int16_t*)(blob + sizeof(h)));
+    }
+    free(blob);
+}
+
+/* v2 API: set parameter
+ * Updates the UI-side parameter set and publishes it to the audio thread. */
+static void v2_set_param(void *instance, const char *key, const char *val) {
+    psxverb_instance_t *inst = (psxverb_instance_t*)instance;
+    if (!inst || !key || !val) return;
+    psxverb_params_t *ui = &inst->ui;
+
+    /* State restore from patch save */
+    if (strcmp(key, "state") == 0 || strcmp(key, "state_bin") == 0) {
+        ui->restores++;
+        if (key[5]) {
+            v2_set_state_bin(inst, val);
+        } else {
+            state_fields_t f;
+            state_parse_json(val, &f);
+            v2_apply_state(inst, &f);
+        }
+        inst->state_json_len = 0;
+        mailbox_publish(&inst->mailbox, ui);
+        return;
+    }
+
+    if (strcmp(key, "preset") == 0 || strcmp(key, "model") == 0) {
+        /* Accept both string names and numeric indices */
+        int idx = preset_find(val);
+        if (idx < 0 || idx == ui->preset) return;
+        if (v2_select_preset(inst, idx) != 0) return;
+    } else if (strcmp(key, "decay") == 0) {
+        ui->decay = clamp_f(atof(val), 0.0f, 1.0f);
+    } else if (strcmp(key, "mix") == 0) {
+        ui->mix = clamp_f(atof(val), 0.0f, 1.0f);
+    } else if (strcmp(key, "input_gain") == 0) {
+        ui->input_gain = clamp_f(atof(val), 0.0f, 1.0f);
     } else if (strcmp(key, "reverb_level") == 0) {
-        inst->reverb_level = clamp_f(atof(val), 0.0f, 1.0f);
-        float out_scale = inst->reverb_level * 4.0f;
-        inst->current.vLOUT_f = inst->base.vLOUT_f * out_scale;
-        inst->current.vROUT_f = inst->base.vROUT_f * out_scale;
+        ui->reverb_level = clamp_f(atof(val), 0.0f, 1.0f);
+    } else if (strcmp(key, "crossfade") == 0) {
+        ui->crossfade_ms = clamp_f(atof(val), 0.0f, CROSSFADE_MAX_MS);
+    } else if (strcmp(key, "engine") == 0) {
+        int e = -1;
+        for (int i = 0; i < ENGINE_COUNT; i++) {
+            if (strcmp(val, g_engine_names[i]) == 0) e = i;
+        }
+        if (e < 0) e = atoi(val);
+        if (e < 0 || e >= ENGINE_COUNT) return;
+        ui->engine = e;
+#if PSXVERB_PROFILE
+    } else if (strcmp(key, "perf_reset") == 0) {
+        atomic_store_explicit(&inst->perf.reset, 1, memory_order_release);
+        return;
+#endif
+    } else if (strcmp(key, "routing") == 0) {
+        int rt = -1;
+        for (int i = 0; i < ROUTING_COUNT; i++) {
+            if (strcmp(val, g_routing_names[i]) == 0) rt = i;
+        }
+        if (rt < 0) rt = atoi(val);
+        if (rt < 0 || rt >= ROUTING_COUNT) return;
+        ui->routing = rt;
+    } else if (strcmp(key, "resampler") == 0) {
+        int rs = -1;
+        for (int i = 0; i < RESAMPLER_COUNT; i++) {
+            if (strcmp(val, g_resampler_names[i]) == 0) rs = i;
+        }
+        if (rs < 0) rs = atoi(val);
+        if (rs < 0 || rs >= RESAMPLER_COUNT) return;
+        ui->resampler = rs;
+    } else if (strcmp(key, "freeze") == 0 && inst->lanes == 1) {
+        int fz = -1;
+        for (int i = 0; i < FREEZE_COUNT; i++) {
+            if (strcmp(val, g_freeze_names[i]) == 0) fz = i;
+        }
+        if (fz < 0) fz = atoi(val);
+        if (fz < 0 || fz >= FREEZE_COUNT) return;
+        ui->freeze = fz;
+    } else if (strcmp(key, "snapshot") == 0) {
+        if (inst->lanes == 1) v2_snapshot_param(inst, val);
+        return;
+    } else {
+        return;
+    }
+    inst->state_json_len = 0;
+    mailbox_publish(&inst->mailbox, ui);
+}
+
+/* chain_params JSON. The model options come from the preset list, so it is
+ * built on first request and kept for the process lifetime. */
+static const char *const g_chain_params_head =
+    "[{\"key\":\"model\",\"name\":\"Model\",\"type\":\"enum\",\"options\":[";
+static const char *const g_chain_params_tail = "],\"default\":\"Hall\"},"
+    "{\"key\":\"decay\",\"name\":\"Decay\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.7,\"step\":0.01},"
+    "{\"key\":\"mix\",\"name\":\"Mix\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.35,\"step\":0.01},"
+    "{\"key\":\"input_gain\",\"name\":\"Input\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.5,\"step\":0.01},"
+    "{\"key\":\"reverb_level\",\"name\":\"Level\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.5,\"step\":0.01},"
+    "{\"key\":\"crossfade\",\"name\":\"X-Fade\",\"type\":\"float\",\"min\":0,\"max\":2000,\"default\":200,\"step\":10},"
+    "{\"key\":\"engine\",\"name\":\"Engine\",\"type\":\"enum\",\"options\":[\"Float\",\"Fixed\"],\"default\":\"Float\"},"
+    "{\"key\":\"routing\",\"name\":\"Routing\",\"type\":\"enum\",\"options\":[\"Insert\",\"Wet\",\"Mono\"],\"default\":\"Insert\"},"
+    "{\"key\":\"resampler\",\"name\":\"Resampler\",\"type\":\"enum\",\"options\":[\"39-tap\",\"11-tap\",\"2-tap\",\"IIR\"],\"default\":\"39-tap\"},"
+    "{\"key\":\"freeze\",\"name\":\"Freeze\",\"type\":\"enum\",\"options\":[\"Off\",\"Loop\",\"Reverse\"],\"default\":\"Off\"}"
+    "]";
+static char *g_chain_params;
+static int g_chain_params_len;
+
+static const char *v2_chain_params(void) {
+    while (atomic_flag_test_and_set_explicit(&g_bank_lock, memory_order_acquire)) {}
+    if (!g_chain_params) {
+        size_t len = strlen(g_chain_params_head) + strlen(g_chain_params_tail) + 1;
+        for (int i = 0; i < g_preset_count; i++) len += strlen(g_preset_list[i].name) + 3;
+        char *json = (char*)malloc(len);
+        if (json) {
+            char *p = json + sprintf(json, "%s", g_chain_params_head);
+            for (int i = 0; i < g_preset_count; i++) {
+                p += sprintf(p, "%s\"%s\"", i ? "," : "", g_preset_list[i].name);
+            }
+            strcpy(p, g_chain_params_tail);
+            g_chain_params_len = (int)(p - json) + (int)strlen(g_chain_params_tail);
+            g_chain_params = json;
+        }
     }
+    atomic_flag_clear_explicit(&g_bank_lock, memory_order_release);
+    return g_chain_params;
 }
 
-/* v2 API: get parameter */
+/* v2 API: get parameter (reads the UI-side parameter set only) */
 static int v2_get_param(void *instance, const char *key, char *buf, int buf_len) {
     psxverb_instance_t *inst = (psxverb_instance_t*)instance;
     if (!inst || !key || !buf || buf_len <= 0) return -1;
 
     if (strcmp(key, "preset") == 0 || strcmp(key, "model") == 0) {
         /* Return preset name for enum type compatibility */
-        return snprintf(buf, buf_len, "%s", g_presets[inst->preset_idx].name);
+        return snprintf(buf, buf_len, "%s", g_preset_list[inst->ui.preset].name);
     } else if (strcmp(key, "preset_name") == 0 || strcmp(key, "model_name") == 0) {
-        return snprintf(buf, buf_len, "%s", g_presets[inst->preset_idx].name);
+        return snprintf(buf, buf_len, "%s", g_preset_list[inst->ui.preset].name);
     } else if (strcmp(key, "preset_count") == 0) {
-        return snprintf(buf, buf_len, "6");
+        return snprintf(buf, buf_len, "%d", g_preset_count);
     } else if (strcmp(key, "decay") == 0) {
-        return snprintf(buf, buf_len, "%.2f", (double)inst->decay);
+        return snprintf(buf, buf_len, "%.2f", (double)inst->ui.decay);
     } else if (strcmp(key, "mix") == 0) {
-        return snprintf(buf, buf_len, "%.2f", (double)inst->mix);
+        return snprintf(buf, buf_len, "%.2f", (double)inst->ui.mix);
     } else if (strcmp(key, "input_gain") == 0) {
-        return snprintf(buf, buf_len, "%.2f", (double)inst->input_gain);
+        return snprintf(buf, buf_len, "%.2f", (double)inst->ui.input_gain);
     } else if (strcmp(key, "reverb_level") == 0) {
-        return snprintf(buf, buf_len, "%.2f", (double)inst->reverb_level);
+        return snprintf(buf, buf_len, "%.2f", (double)inst->ui.reverb_level);
+    } else if (strcmp(key, "crossfade") == 0) {
+        return snprintf(buf, buf_len, "%.0f", (double)inst->ui.crossfade_ms);
+    } else if (strcmp(key, "engine") == 0) {
+        return snprintf(buf, buf_len, "%s", g_engine_names[inst->ui.engine]);
+    } else if (strcmp(key, "routing") == 0) {
+        return snprintf(buf, buf_len, "%s", g_routing_names[inst->ui.routing]);
+    } else if (strcmp(key, "resampler") == 0) {
+        return snprintf(buf, buf_len, "%s", g_resampler_names[inst->ui.resampler]);
+    } else if (strcmp(key, "freeze") == 0) {
+        return snprintf(buf, buf_len, "%s", g_freeze_names[inst->ui.freeze]);
+    } else if (strcmp(key, "snapshot") == 0) {
+        uint32_t taken = atomic_load_explicit(&inst->snap_taken, memory_order_relaxed);
+        return snprintf(buf, buf_len, "{\"slots\":%d,\"taken\":%u}", PSXVERB_SNAPSHOT_SLOTS,
+                        taken < PSXVERB_SNAPSHOT_SLOTS ? taken : PSXVERB_SNAPSHOT_SLOTS);
     } else if (strcmp(key, "name") == 0) {
         return snprintf(buf, buf_len, "PSX Verb");
+    } else if (strcmp(key, "latency_samples") == 0) {
+        /* Wet path delay at the host rate for the selected resampler, plus
+         * the frame held back once an odd block size has been seen (which
+         * delays the dry signal too) */
+        uint32_t carry = atomic_load_explicit(&inst->carry_latency, memory_order_relaxed);
+        return snprintf(buf, buf_len, "%d",
+                        g_resampler_latency[inst->ui.resampler] + (int)carry);
+    } else if (strcmp(key, "denormals") == 0) {
+        return snprintf(buf, buf_len, "{\"ftz\":%s,\"floor_chunks\":%u}",
+                        PSXVERB_FTZ ? "true" : "false",
+                        atomic_load_explicit(&inst->denormal_chunks, memory_order_relaxed));
+    } else if (strcmp(key, "memory") == 0) {
+        return v2_get_memory(inst, buf, buf_len);
+    } else if (strcmp(key, "meters") == 0) {
+        return v2_get_meters(inst, buf, buf_len);
+#if PSXVERB_PROFILE
+    } else if (strcmp(key, "perf_stats") == 0) {
+        return v2_get_perf_stats(inst, buf, buf_len);
+#endif
     } else if (strcmp(key, "state") == 0) {
-        return snprintf(buf, buf_len,
-            "{\"preset\":%d,\"decay\":%.4f,\"mix\":%.4f,"
-            "\"input_gain\":%.4f,\"reverb_level\":%.4f}",
-            inst->preset_idx, inst->decay, inst->mix,
-            inst->input_gain, inst->reverb_level);
+        return v2_get_state_json(inst, buf, buf_len);
+    } else if (strcmp(key, "state_bin") == 0) {
+        return v2_get_state_bin(inst, buf, buf_len);
     }
 
     /* UI hierarchy for shadow parameter editor - flat list */
     if (strcmp(key, "ui_hierarchy") == 0) {
-        const char *hierarchy = "{"
+        static const char hierarchy[] = "{"
             "\"modes\":null,"
             "\"levels\":{"
                 "\"root\":{"
                     "\"children\":null,"
                     "\"knobs\":[\"model\",\"decay\",\"mix\",\"reverb_level\"],"
-                    "\"params\":[\"model\",\"decay\",\"mix\",\"input_gain\",\"reverb_level\"]"
+                    "\"params\":[\"model\",\"decay\",\"mix\",\"input_gain\",\"reverb_level\",\"crossfade\",\"engine\",\"routing\",\"resampler\",\"freeze\"]"
                 "}"
             "}"
         "}";
-        int len = strlen(hierarchy);
-        if (len < buf_len) {
-            strcpy(buf, hierarchy);
-            return len;
-        }
-        return -1;
+        return copy_blob(buf, buf_len, hierarchy, (int)sizeof(hierarchy) - 1);
     }
 
     /* Chain params metadata for shadow parameter editor */
     if (strcmp(key, "chain_params") == 0) {
-        const char *params_json = "["
-            "{\"key\":\"model\",\"name\":\"Model\",\"type\":\"enum\",\"options\":[\"Room\",\"Studio S\",\"Studio M\",\"Studio L\",\"Hall\",\"Space Echo\"],\"default\":\"Hall\"},"
-            "{\"key\":\"decay\",\"name\":\"Decay\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.7,\"step\":0.01},"
-            "{\"key\":\"mix\",\"name\":\"Mix\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.35,\"step\":0.01},"
-            "{\"key\":\"input_gain\",\"name\":\"Input\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.5,\"step\":0.01},"
-            "{\"key\":\"reverb_level\",\"name\":\"Level\",\"type\":\"float\",\"min\":0,\"max\":1,\"default\":0.5,\"step\":0.01}"
-        "]";
-        int len = strlen(params_json);
-        if (len < buf_len) {
-            strcpy(buf, params_json);
-            return len;
-        }
-        return -1;
+        const char *params_json = v2_chain_params();
+        if (!params_json) return -1;
+        return copy_blob(buf, buf_len, params_json, g_chain_params_len);
     }
 
     return -1;
@@ -887,9 +4754,16 @@ audio_fx_api_v2_t* move_audio_fx_init_v2(const host_api_v1_t *host) {
 
     memset(&g_fx_api_v2, 0, sizeof(g_fx_api_v2));
     g_fx_api_v2.api_version = AUDIO_FX_API_VERSION_2;
+    if (host && host->api_version >= HOST_API_VERSION_F32) g_fx_api_v2.api_version = AUDIO_FX_API_VERSION_2_F32;
+    if (host && host->api_version >= HOST_API_VERSION_MULTI) g_fx_api_v2.api_version = AUDIO_FX_API_VERSION_2_MULTI;
     g_fx_api_v2.create_instance = v2_create_instance;
     g_fx_api_v2.destroy_instance = v2_destroy_instance;
+#if PSXVERB_PROFILE
+    perf_init_timer();
+#endif
     g_fx_api_v2.process_block = v2_process_block;
+    g_fx_api_v2.process_block_f32 = v2_process_block_f32;
+    g_fx_api_v2.process_block_multi = v2_process_block_multi;
     g_fx_api_v2.set_param = v2_set_param;
     g_fx_api_v2.get_param = v2_get_param;
 